@@ -4,19 +4,28 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../MEWCP_combinatorial_bound.c \
+../MEWCP_cutting_planes.c \
 ../MEWCP_dsdp.c \
+../MEWCP_explicit_enumeration.c \
 ../MEWCP_tabu.c \
 ../converter_dsdp.c \
 ../main.c 
 
 OBJS += \
+./MEWCP_combinatorial_bound.o \
+./MEWCP_cutting_planes.o \
 ./MEWCP_dsdp.o \
+./MEWCP_explicit_enumeration.o \
 ./MEWCP_tabu.o \
 ./converter_dsdp.o \
 ./main.o 
 
 C_DEPS += \
+./MEWCP_combinatorial_bound.d \
+./MEWCP_cutting_planes.d \
 ./MEWCP_dsdp.d \
+./MEWCP_explicit_enumeration.d \
 ./MEWCP_tabu.d \
 ./converter_dsdp.d \
 ./main.d 
@@ -26,7 +35,7 @@ C_DEPS += \
 %.o: ../%.c
 	@echo 'Building file: $<'
 	@echo 'Invoking: GCC C Compiler'
-	gcc -O0 -g3 -pedantic -Wall -std=c99  -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.d)" -o"$@" "$<"
+	gcc -O0 -g3 -pedantic -Wall -std=c99 -pthread  -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.d)" -o"$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
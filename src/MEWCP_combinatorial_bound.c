@@ -10,88 +10,114 @@
 #include "MEWCP_tabu.h"
 #include "converter_dsdp.h"
 
-void MEWCP_compute_combinatorial_preprocessing(open_node_t * root_node, matrix_weights_t * matrix_weights,
+void MEWCP_compute_combinatorial_preprocessing(open_node_t * root_node, bound_workspace_t * bound_workspaces,
+        matrix_weights_t * matrix_weights,
         const unsigned int num_partitions,
         const unsigned int cardinality_partitions,
-        const double initial_best_primal)
+        const double initial_best_primal,
+        const unsigned int num_threads)
 {
 #if defined MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
     printf("\n* MEWCP_compute_combinatorial_preprocessing *\n");
 #endif
 
-    unsigned int i,k,n,dim_vect;
-    n = num_partitions * cardinality_partitions;
-    double vect_dual[n];  // I save the DB for each iteration
+    unsigned int i,n,dim_vect;
+    unsigned int num_passes;
+    unsigned int num_new_blocked;
+    unsigned int num_new_conflicts;
+    double * vect_dual;  // I save the DB for each iteration
 
-    list_blocked_nodes_t * current_list_blocked_nodes;
     list_blocked_nodes_t * final_list_blocked_nodes;
-    open_node_t * current_open_node;
+    preprocessing_context_t preprocessing_context;
+    preprocessing_worker_t * preprocessing_workers;
+    sorted_neighbour_t * sorted_probes;
     double best_primal;
 
-    best_primal = initial_best_primal;
+    n = num_partitions * cardinality_partitions;
     final_list_blocked_nodes = MEWCP_allocate_list_blocked_nodes(num_partitions*cardinality_partitions);
+    MEWCP_clone_list_blocked_modes(root_node->list_blocked_nodes,final_list_blocked_nodes,n);
 
-    for (k = 0; k<num_partitions; ++k)
+    vect_dual = (double *) calloc(n,sizeof(double));
+    preprocessing_workers = (preprocessing_worker_t *) calloc(num_threads,sizeof(preprocessing_worker_t));
+    if ( (vect_dual == NULL) || (preprocessing_workers == NULL) )
     {
-        for (i = k*cardinality_partitions; i <  (k*cardinality_partitions + cardinality_partitions); ++i)
-        {
-            current_list_blocked_nodes = MEWCP_blocked_other_nodes_of_partition(i,k,num_partitions,cardinality_partitions);
-            current_open_node = MEWCP_allocate_open_node();
-
-            current_open_node->list_blocked_nodes = current_list_blocked_nodes;
-
-            MEWCP_bound_combinatorial(current_open_node,matrix_weights,num_partitions,cardinality_partitions,best_primal);
-
-            vect_dual[i] = current_open_node->DB;
-#if defined MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
+        printf("!!! ERROR allocation preprocessing! \n");
+        exit(EXIT_FAILURE);
+    }
 
-            printf("---> node: %d \t DB: %.2lf\n",i,vect_dual[i]);
+    /* The probes are independent, the workers take them in chunks and share the best primal */
+    preprocessing_context.matrix_weights = matrix_weights;
+    preprocessing_context.num_partitions = num_partitions;
+    preprocessing_context.cardinality_partitions = cardinality_partitions;
+    preprocessing_context.list_blocked_nodes = final_list_blocked_nodes;
+    preprocessing_context.best_primal = initial_best_primal;
+    preprocessing_context.vect_dual = vect_dual;
+    preprocessing_context.candidates = NULL;
+    preprocessing_context.new_conflicts = NULL;
+    sorted_probes = NULL;
+
+#if defined CONFLICTS_ACTIVE
+    preprocessing_context.candidates = (int *) calloc(MEWCP_CONFLICT_CANDIDATES,sizeof(int));
+    preprocessing_context.new_conflicts = (bool *) calloc(MEWCP_CONFLICT_CANDIDATES*n,sizeof(bool));
+    sorted_probes = (sorted_neighbour_t *) calloc(n,sizeof(sorted_neighbour_t));
+    if ( (preprocessing_context.candidates == NULL) || (preprocessing_context.new_conflicts == NULL) || (sorted_probes == NULL) )
+    {
+        printf("!!! ERROR allocation preprocessing conflicts! \n");
+        exit(EXIT_FAILURE);
+    }
 #endif
 
-            if ( (current_open_node->PB - best_primal) >  MEWCP_EPSILON)
-            {
-                best_primal = current_open_node->PB;
-#if defined MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
+    for (i=0; i<num_threads; ++i)
+    {
+        preprocessing_workers[i].id_worker = i;
+        preprocessing_workers[i].preprocessing_context = &preprocessing_context;
+        preprocessing_workers[i].workspace = &bound_workspaces[i];
+    }
 
-                printf("Preprocessing New best PB k: %d i: %d\t PB: %.2lf\n",k,i,best_primal);
-#endif
+    /* A block makes the probes of the other nodes tighter, a better primal or a conflict may block
+     * more nodes: the passes are repeated until nothing changes
+     */
+    num_passes = 0;
+    do
+    {
+        preprocessing_context.pair_pass = false;
+        preprocessing_context.num_probes = n;
+        MEWCP_run_preprocessing_workers(preprocessing_workers,num_threads);
+        num_passes++;
 
-            }
+        best_primal = preprocessing_context.best_primal;
+        num_new_blocked = MEWCP_block_preprocessing_probes(vect_dual,best_primal,final_list_blocked_nodes,n);
+        num_new_conflicts = 0;
 
-            /* all done, I can deallocate the current node */
-            MEWCP_free_list_blocked_nodes(current_list_blocked_nodes);
-            free(current_open_node); /* It contains no vectors */
+#if defined CONFLICTS_ACTIVE
+        if (num_new_blocked == 0)
+        {
+            num_new_conflicts = MEWCP_compute_preprocessing_conflicts(preprocessing_workers,num_threads,sorted_probes);
+            num_passes++;
 
+            if (num_new_conflicts > 0)
+            {
+                /* The best edges kept by the probes may be in conflict now */
+                for (i=0; i<num_threads; ++i)
+                {
+                    MEWCP_copy_combinatorial_cache(NULL,bound_workspaces[i].probe_node->combinatorial_cache);
+                }
+            }
 
+            /* The pairs may have improved the best primal */
+            best_primal = preprocessing_context.best_primal;
+            num_new_blocked = MEWCP_block_preprocessing_probes(vect_dual,best_primal,final_list_blocked_nodes,n);
         }
+#endif
     }
+    while ( (num_new_blocked > 0) || (num_new_conflicts > 0) );
+
 #if defined MEWCP_COMBINATORIAL_PREPROCESSING_VERBOSE1
 
     printf("\n Best_primal: %.2lf\n",best_primal);
+    printf("Preprocessing passes: %u\t blocked nodes: %u\t conflicts: %u\n",num_passes,final_list_blocked_nodes->num_blocked_nodes,matrix_weights->num_conflicts);
 #endif
 
-    /* now let's check if the node is about to be close
-                 * in this case I add the only free element of the partition to the final_blocked_list */
-    for (i=0;i<n;++i)
-    {
-        if ((best_primal - vect_dual[i] ) > MEWCP_EPSILON  )
-        {
-#if defined MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
-            printf("XXX Preprocessing Node to be close! i: %d\t DB: %.2lf\n",i,vect_dual[i]);
-#endif
-            /* I add the node i to the list of final blocked nodes */
-            MEWCP_add_blocked_node(i,final_list_blocked_nodes);
-
-        }
-        else
-        {
-#if defined MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
-            printf("OOOOO Preprocessing Node survives:  i: %d\t DB: %.2lf\n",i,vect_dual[i]);
-#endif
-
-        }
-    }
-
 
     /* Before I go I modify the root node given with the final blocked list nodes and
      * I generate the correspondant branching constraint according to the blocked list
@@ -110,230 +136,712 @@ void MEWCP_compute_combinatorial_preprocessing(open_node_t * root_node, matrix_w
 
     root_node->list_blocked_nodes = final_list_blocked_nodes;
 
+    /* The combinatorial bound of the root starts from a probe */
+    MEWCP_free_combinatorial_cache(root_node->combinatorial_cache);
+    root_node->combinatorial_cache = MEWCP_clone_combinatorial_cache(bound_workspaces[0].probe_node->combinatorial_cache);
+
+    free(vect_dual);
+    free(preprocessing_workers);
+    free(preprocessing_context.candidates);
+    free(preprocessing_context.new_conflicts);
+    free(sorted_probes);
+
 
     dim_vect = n*(n+1)/2;
-    MEWCP_allocate_vect_mat_branching_constraints(dim_vect);
+    root_node->vect_mat_branching_contraint = MEWCP_allocate_vect_mat_branching_constraints(dim_vect);
     MEWCP_generate_constraints_branch(final_list_blocked_nodes,root_node->vect_mat_branching_contraint,dim_vect,n,cardinality_partitions);
 
 
 }
 
 
-
-list_blocked_nodes_t * MEWCP_blocked_other_nodes_of_partition(const unsigned int pos,
-        const unsigned int partition,
-        const unsigned int num_partitions,
-        const unsigned int cardinality_partitions)
+void MEWCP_run_preprocessing_workers(preprocessing_worker_t * preprocessing_workers, const unsigned int num_threads)
 {
     unsigned int i;
 
-    list_blocked_nodes_t * list_blocked_nodes;
-    list_blocked_nodes = MEWCP_allocate_list_blocked_nodes(num_partitions*cardinality_partitions);
+    preprocessing_workers[0].preprocessing_context->next_probe = 0;
 
-    for (i = partition*cardinality_partitions; i < ( partition*cardinality_partitions + cardinality_partitions); ++i)
+    if (num_threads <= 1)
     {
-        if (i != pos)
+        MEWCP_preprocessing_worker(&preprocessing_workers[0]);
+        return;
+    }
+
+    for (i=0; i<num_threads; ++i)
+    {
+        if (pthread_create(&preprocessing_workers[i].thread, NULL, MEWCP_preprocessing_worker, &preprocessing_workers[i]) != 0)
         {
+            printf("!!! ERROR creation of preprocessing worker %u! \n",i);
+            exit(EXIT_FAILURE);
+        }
+    }
 
-            MEWCP_add_blocked_node(i,list_blocked_nodes);
-#if defined  MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
+    for (i=0; i<num_threads; ++i)
+    {
+        pthread_join(preprocessing_workers[i].thread, NULL);
+    }
+}
 
-            //printf("other node part: %d\tblocked: %d\n",partition,i);
+
+unsigned int MEWCP_block_preprocessing_probes(const double * vect_dual, const double best_primal,
+        list_blocked_nodes_t * list_blocked_nodes,
+        const unsigned int num_nodes)
+{
+    unsigned int i;
+    unsigned int num_new_blocked = 0;
+
+    /* now let's check if the node is about to be close
+     * in this case I add it to the final blocked list */
+    for (i=0;i<num_nodes;++i)
+    {
+        if (list_blocked_nodes->bool_list[i] == true)
+        {
+            continue;
+        }
+        if ((best_primal - vect_dual[i] ) > MEWCP_EPSILON  )
+        {
+#if defined MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
+            printf("XXX Preprocessing Node to be close! i: %d\t DB: %.2lf\n",i,vect_dual[i]);
+#endif
+            MEWCP_add_blocked_node(i,list_blocked_nodes);
+            num_new_blocked++;
+        }
+        else
+        {
+#if defined MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
+            printf("OOOOO Preprocessing Node survives:  i: %d\t DB: %.2lf\n",i,vect_dual[i]);
 #endif
 
         }
     }
 
+    return num_new_blocked;
+}
 
 
-    return list_blocked_nodes;
+unsigned int MEWCP_compute_preprocessing_conflicts(preprocessing_worker_t * preprocessing_workers, const unsigned int num_threads,
+        sorted_neighbour_t * sorted_probes)
+{
+    preprocessing_context_t * preprocessing_context = preprocessing_workers[0].preprocessing_context;
+    matrix_weights_t * matrix_weights = preprocessing_context->matrix_weights;
+    bool * bool_list = preprocessing_context->list_blocked_nodes->bool_list;
+    unsigned int i,r,n;
+    unsigned int num_free_nodes;
+    unsigned int num_candidates;
+    unsigned int num_new_conflicts = 0;
+
+    n = preprocessing_context->num_partitions * preprocessing_context->cardinality_partitions;
+
+    /* The candidates are the free nodes nearest to be blocked */
+    num_free_nodes = 0;
+    for (i=0; i<n; ++i)
+    {
+        if (bool_list[i] == false)
+        {
+            sorted_probes[num_free_nodes].key = -preprocessing_context->vect_dual[i];
+            sorted_probes[num_free_nodes].node = i;
+            num_free_nodes++;
+        }
+    }
+    qsort(sorted_probes, num_free_nodes, sizeof(sorted_neighbour_t), sort_compare_neighbours);
+
+    num_candidates = num_free_nodes;
+    if (num_candidates > MEWCP_CONFLICT_CANDIDATES)
+    {
+        num_candidates = MEWCP_CONFLICT_CANDIDATES;
+    }
+    for (r=0; r<num_candidates; ++r)
+    {
+        preprocessing_context->candidates[r] = sorted_probes[r].node;
+    }
 
+    memset(preprocessing_context->new_conflicts, 0, num_candidates*n*sizeof(bool));
+    preprocessing_context->pair_pass = true;
+    preprocessing_context->num_probes = num_candidates;
+    MEWCP_run_preprocessing_workers(preprocessing_workers,num_threads);
+
+    /* The rows are joined in the conflicts of the instance, both ways */
+    num_new_conflicts = MEWCP_add_conflicts(matrix_weights,preprocessing_context->candidates,preprocessing_context->new_conflicts,num_candidates);
+
+    return num_new_conflicts;
 }
 
 
-void MEWCP_bound_combinatorial(open_node_t * open_node,
-                               matrix_weights_t * matrix_weights,
-                               const unsigned int num_partitions,
-                               const unsigned int cardinality_partitions,
-                               const double best_primal)
+bool MEWCP_is_new_conflict(const matrix_weights_t * matrix_weights, const int * candidates, const bool * new_conflicts,
+                           const unsigned int r, const unsigned int j)
 {
-#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
-    printf("\n* MEWCP_bound_combinatorial *\n");
-#endif
+    unsigned int i,s,n;
 
-    unsigned int i,j,k,t,z,r;
-    double z_primal;
-    double sum_i,sum_j;
-    double total_sum = 0;
-    double sum_tmp;
+    n = matrix_weights->n;
+    i = candidates[r];
+    if ( (new_conflicts[r*n + j] == false) || (MEWCP_is_conflict(matrix_weights,i,j) == true) )
+    {
+        return false;
+    }
 
-    /* Vector of selected nodes for each partition Vk, k=1,..,m */
-    int selected_node[num_partitions];
-    double value_k[num_partitions];
+    /* Two candidates may have found the same pair, the first row takes it */
+    for (s=0; s<r; ++s)
+    {
+        if ( ((unsigned int) candidates[s] == j) && (new_conflicts[s*n + i] == true) )
+        {
+            return false;
+        }
+    }
 
-    int tmp_selected_edges[num_partitions];
+    return true;
+}
+
+
+unsigned int MEWCP_add_conflicts(matrix_weights_t * matrix_weights, const int * candidates, const bool * new_conflicts,
+                                 const unsigned int num_candidates)
+{
+    unsigned int i,j,r,s,n;
+    unsigned int num_new_conflicts = 0;
+    unsigned int * conflict_start;
+    unsigned int * conflict_nodes;
+    unsigned int * row_end;
 
-    /* for each partition Vk I say which are the nodes connected to selected node in Vk */
-    int selected_edges[num_partitions][num_partitions];
+    n = matrix_weights->n;
 
-    for(i=0;i<num_partitions;++i)
+    conflict_start = (unsigned int *) calloc(n+1,sizeof(unsigned int));
+    row_end = (unsigned int *) calloc(n,sizeof(unsigned int));
+    if ( (conflict_start == NULL) || (row_end == NULL) )
+    {
+        printf("!!! ERROR allocation conflicts! \n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* conflict_start[i+1] counts the row of i: the old pairs and the new ones, taken once if two candidates found them */
+    if (matrix_weights->conflict_start != NULL)
+    {
+        for (i=0; i<n; ++i)
+        {
+            conflict_start[i+1] = matrix_weights->conflict_start[i+1] - matrix_weights->conflict_start[i];
+        }
+    }
+    for (r=0; r<num_candidates; ++r)
     {
-        for(j=0;j<num_partitions;++j)
+        i = candidates[r];
+        for (j=0; j<n; ++j)
         {
-            selected_edges[i][j] = -1;
+            if (MEWCP_is_new_conflict(matrix_weights,candidates,new_conflicts,r,j) == true)
+            {
+                conflict_start[i+1]++;
+                conflict_start[j+1]++;
+                num_new_conflicts++;
+            }
         }
     }
 
+    if (num_new_conflicts == 0)
+    {
+        free(conflict_start);
+        free(row_end);
+        return 0;
+    }
 
+    for (i=0; i<n; ++i)
+    {
+        conflict_start[i+1] += conflict_start[i];
+    }
+    conflict_nodes = (unsigned int *) calloc(conflict_start[n],sizeof(unsigned int));
+    if (conflict_nodes == NULL)
+    {
+        printf("!!! ERROR allocation conflicts! \n");
+        exit(EXIT_FAILURE);
+    }
 
-#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
-    printf("m: %d\tc: %d\n",num_partitions, cardinality_partitions);
-    MEWCP_print_list_blocked_nodes(open_node->list_blocked_nodes);
+    /* The old rows first, then the new pairs with the same test as above */
+    for (i=0; i<n; ++i)
+    {
+        row_end[i] = conflict_start[i];
+        if (matrix_weights->conflict_start != NULL)
+        {
+            for (s=matrix_weights->conflict_start[i]; s<matrix_weights->conflict_start[i+1]; ++s)
+            {
+                conflict_nodes[row_end[i]++] = matrix_weights->conflict_nodes[s];
+            }
+        }
+    }
+    for (r=0; r<num_candidates; ++r)
+    {
+        i = candidates[r];
+        for (j=0; j<n; ++j)
+        {
+            if (MEWCP_is_new_conflict(matrix_weights,candidates,new_conflicts,r,j) == true)
+            {
+#if defined MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
+                printf("### Preprocessing Conflict: i: %d\t j: %d\n",i,j);
 #endif
+                conflict_nodes[row_end[i]++] = j;
+                conflict_nodes[row_end[j]++] = i;
+            }
+        }
+    }
 
-    for ( k = 0; k<num_partitions; ++k)
+    /* MEWCP_is_conflict looks for j by bisection */
+    for (i=0; i<n; ++i)
     {
+        qsort(&conflict_nodes[conflict_start[i]], conflict_start[i+1] - conflict_start[i], sizeof(unsigned int), sort_compare);
+    }
 
-        sum_i = MEWCP_MIN_DOUBLE;
-#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
+    MEWCP_free_conflicts(matrix_weights);
+    matrix_weights->conflict_start = conflict_start;
+    matrix_weights->conflict_nodes = conflict_nodes;
+    matrix_weights->num_conflicts = conflict_start[n]/2;
+    free(row_end);
 
-        printf("Azzero sum_i\n");
-#endif
+    return num_new_conflicts;
+}
 
-        for(i = cardinality_partitions*k; i< (cardinality_partitions*k +cardinality_partitions); ++i)
+
+void * MEWCP_preprocessing_worker(void * arg)
+{
+    preprocessing_worker_t * preprocessing_worker = (preprocessing_worker_t *) arg;
+    preprocessing_context_t * preprocessing_context = preprocessing_worker->preprocessing_context;
+    unsigned int i,first_probe,last_probe,chunk;
+
+    /* A row of pairs is as long as a whole chunk of nodes */
+    chunk = (preprocessing_context->pair_pass == true) ? 1 : MEWCP_PREPROCESSING_CHUNK;
+
+    while (true)
+    {
+        /* Consecutive probes differ by one or two partitions, a chunk keeps the cache useful */
+        first_probe = __atomic_fetch_add(&preprocessing_context->next_probe, chunk, __ATOMIC_RELAXED);
+        if (first_probe >= preprocessing_context->num_probes)
         {
-            if (open_node->list_blocked_nodes->bool_list[i] == true)
-            {
-                //#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
-                //              printf("Nodo i: %d bloccato\n",i);
-                //#endif
+            break;
+        }
+        last_probe = first_probe + chunk;
+        if (last_probe > preprocessing_context->num_probes)
+        {
+            last_probe = preprocessing_context->num_probes;
+        }
 
-                continue;
+        for (i = first_probe; i < last_probe; ++i)
+        {
+            if (preprocessing_context->pair_pass == true)
+            {
+                MEWCP_preprocessing_probe_pairs(preprocessing_worker,i);
             }
-#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
-            printf("i: %d\t k: %d\n",i,k);
-#endif
-
-            for(z=0;z<num_partitions;++z)
+            else
             {
-                tmp_selected_edges[z] = -1;
+                MEWCP_preprocessing_probe_node(preprocessing_worker,i);
             }
+        }
+    }
 
-            for(t=((k+1)%num_partitions), r=0;  r<num_partitions-1; t = ((t+1) % num_partitions), ++r)
-            {
+    return NULL;
+}
 
-#if defined ASSERT
-                assert(t != k);
-#endif
 
-                sum_j = MEWCP_MIN_DOUBLE;
+void MEWCP_preprocessing_probe_node(preprocessing_worker_t * preprocessing_worker, const unsigned int i)
+{
+    preprocessing_context_t * preprocessing_context = preprocessing_worker->preprocessing_context;
+    unsigned int num_partitions = preprocessing_context->num_partitions;
+    unsigned int cardinality_partitions = preprocessing_context->cardinality_partitions;
+    unsigned int j,k,n;
+    open_node_t * current_open_node;
+    double best_primal;
 
-                for(j = cardinality_partitions*t ; j<(cardinality_partitions*t + cardinality_partitions); ++j)
-                {
+    n = num_partitions * cardinality_partitions;
+    current_open_node = preprocessing_worker->workspace->probe_node;
 
-                    if (open_node->list_blocked_nodes->bool_list[j] == true)
-                    {
-                        //#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
-                        //                        printf("Nodo j: %d bloccato\n",j);
-                        //#endif
+    if (preprocessing_context->list_blocked_nodes->bool_list[i] == true)
+    {
+        /* Blocked by a previous pass */
+        preprocessing_context->vect_dual[i] = (double) MEWCP_MIN_DOUBLE;
+        return;
+    }
 
-                        continue;
-                    }
-                    /* I keep the maximum weight edge*/
+    /* The other nodes of the partition are blocked */
+    k = i / cardinality_partitions;
+    MEWCP_clone_list_blocked_modes(preprocessing_context->list_blocked_nodes,current_open_node->list_blocked_nodes,n);
+    for (j = k*cardinality_partitions; j < (k*cardinality_partitions + cardinality_partitions); ++j)
+    {
+        if (j != i)
+        {
+            MEWCP_add_blocked_node(j,current_open_node->list_blocked_nodes);
+        }
+    }
+    current_open_node->DB = (double) MEWCP_MAX_DOUBLE;
+    current_open_node->PB = (double) MEWCP_MIN_DOUBLE;
 
-                    sum_tmp = matrix_weights->weight[i][j];
-                    sum_tmp += (matrix_weights->weight[j][j])/(num_partitions -1);
+    __atomic_load(&preprocessing_context->best_primal, &best_primal, __ATOMIC_RELAXED);
+    MEWCP_bound_combinatorial(current_open_node,preprocessing_worker->workspace,preprocessing_context->matrix_weights,num_partitions,cardinality_partitions,best_primal);
 
+    preprocessing_context->vect_dual[i] = current_open_node->DB;
+#if defined MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
 
-                    if ( (sum_tmp - sum_j) > MEWCP_EPSILON)
-                    {
-                        sum_j = sum_tmp;
-                        tmp_selected_edges[t] = j;
-                    }
-            
-                }
-#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
-                printf("Partizione k: %d t: %d \tnode: %d\t sum_tmp: %.2lf\n",k,t, tmp_selected_edges[t],sum_tmp);
+    printf("---> node: %d \t DB: %.2lf\n",i,preprocessing_context->vect_dual[i]);
 #endif
 
+    MEWCP_update_preprocessing_best_primal(preprocessing_context,current_open_node->PB);
+}
 
-            }
 
-            /* Before I change i I want to know the value of this sum */
-            sum_tmp = 0;
-            for(z=0;z<num_partitions;++z)
+void MEWCP_preprocessing_probe_pairs(preprocessing_worker_t * preprocessing_worker, const unsigned int r)
+{
+    preprocessing_context_t * preprocessing_context = preprocessing_worker->preprocessing_context;
+    matrix_weights_t * matrix_weights = preprocessing_context->matrix_weights;
+    unsigned int num_partitions = preprocessing_context->num_partitions;
+    unsigned int cardinality_partitions = preprocessing_context->cardinality_partitions;
+    bool * bool_list = preprocessing_context->list_blocked_nodes->bool_list;
+    unsigned int i,j,k,t,l,n;
+    unsigned int num_conflicts_i;
+    open_node_t * current_open_node;
+    double best_primal;
+
+    n = num_partitions * cardinality_partitions;
+    current_open_node = preprocessing_worker->workspace->probe_node;
+    i = preprocessing_context->candidates[r];
+    k = i / cardinality_partitions;
+    (void) MEWCP_get_node_conflicts(matrix_weights,i,&num_conflicts_i);
+
+    for (t = 0; t<num_partitions; ++t)
+    {
+        if (t == k)
+        {
+            continue;
+        }
+        for (j = t*cardinality_partitions; j < (t*cardinality_partitions + cardinality_partitions); ++j)
+        {
+            if ( (bool_list[j] == true) ||
+                 ( (num_conflicts_i > 0) && (MEWCP_is_conflict(matrix_weights,i,j) == true) ) )
             {
-                if(tmp_selected_edges[z] != -1)
-                {
-                    sum_tmp += matrix_weights->weight[i][tmp_selected_edges[z]];
-                    sum_tmp += matrix_weights->weight[tmp_selected_edges[z]][tmp_selected_edges[z]]/(num_partitions -1);
-                }
+                continue;
             }
-            sum_tmp += matrix_weights->weight[i][i];
 
-            if ((sum_tmp - sum_i) > MEWCP_EPSILON)
+            /* Only i and j are free in their partitions */
+            MEWCP_clone_list_blocked_modes(preprocessing_context->list_blocked_nodes,current_open_node->list_blocked_nodes,n);
+            for (l = 0; l < cardinality_partitions; ++l)
             {
-                selected_node[k] = i;
-                for(z=0;z<num_partitions;++z)
+                if ((k*cardinality_partitions + l) != i)
                 {
-                    selected_edges[k][z] = tmp_selected_edges[z];
+                    MEWCP_add_blocked_node(k*cardinality_partitions + l,current_open_node->list_blocked_nodes);
+                }
+                if ((t*cardinality_partitions + l) != j)
+                {
+                    MEWCP_add_blocked_node(t*cardinality_partitions + l,current_open_node->list_blocked_nodes);
                 }
-                sum_i = sum_tmp;
-                value_k[k] = sum_i;
-#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
-
-                printf("Update sum_i: %.2lf\n",sum_i);
-#endif
-
             }
+            current_open_node->DB = (double) MEWCP_MAX_DOUBLE;
+            current_open_node->PB = (double) MEWCP_MIN_DOUBLE;
 
-#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
-            printf("Partition:  k: %d \t taken nodo: %d\t value: %.lf \t best_va: %.2lf\n Edges:",k, selected_node[k],sum_tmp, sum_i);
-            for(z=0;z<num_partitions;++z)
+            __atomic_load(&preprocessing_context->best_primal, &best_primal, __ATOMIC_RELAXED);
+            MEWCP_bound_combinatorial(current_open_node,preprocessing_worker->workspace,matrix_weights,num_partitions,cardinality_partitions,best_primal);
+
+            if ((best_primal - current_open_node->DB ) > MEWCP_EPSILON  )
             {
-                printf("%d ",selected_edges[k][z]);
+                preprocessing_context->new_conflicts[r*n + j] = true;
             }
-            printf("\n\n");
-#endif
 
+            MEWCP_update_preprocessing_best_primal(preprocessing_context,current_open_node->PB);
         }
-
-    }
-
-
-    /* Now let's evaluate the value */
-    total_sum = 0;
-    for (i=0;i<num_partitions;++i)
-    {
-        total_sum += value_k[i];
     }
-    total_sum = total_sum / 2;
+}
 
-#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
-    /* Let's see nodes and edges taken */
 
+void MEWCP_update_preprocessing_best_primal(preprocessing_context_t * preprocessing_context, double primal)
+{
+    double best_primal;
 
-    printf("Taken nodes: ");
-    for (i=0;i<num_partitions;++i)
-    {
-        printf("%d ",selected_node[i]);
-    }
-    printf("\n");
+    __atomic_load(&preprocessing_context->best_primal, &best_primal, __ATOMIC_RELAXED);
 
-    for(i=0; i<num_partitions;++i)
+    /* The best primal only grows */
+    while ( (primal - best_primal) >  MEWCP_EPSILON)
     {
-        printf("Partition: %d \t value: %.2lf\nEdges:",i,value_k[i]);
-        for(j=0;j<num_partitions;++j)
+        if (__atomic_compare_exchange(&preprocessing_context->best_primal, &best_primal, &primal,
+                                      false, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == true)
         {
-            printf(" %d",selected_edges[i][j]);
+#if defined MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
+
+            printf("Preprocessing New best PB: %.2lf\n",primal);
+#endif
+            break;
         }
-        printf("\n");
     }
+}
 
-#endif
 
+bool MEWCP_compute_combinatorial_fixing(open_node_t * open_node, bound_workspace_t * workspace, matrix_weights_t * matrix_weights,
+                                        const unsigned int num_partitions,
+                                        const unsigned int cardinality_partitions,
+                                        const double best_primal,
+                                        unsigned int * out_num_fixed)
+{
+#if defined MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
+    printf("\n* MEWCP_compute_combinatorial_fixing *\n");
+#endif
 
-    z_primal = MEWCP_evaluate_list_nodes_solution(selected_node,matrix_weights,num_partitions);
+    unsigned int i,j,k,n;
+    bool * to_be_blocked;
+    unsigned int num_free_nodes;
+
+    list_blocked_nodes_t * list_blocked_nodes;
+    list_blocked_nodes_t * current_list_blocked_nodes;
+    open_node_t * current_open_node;
+
+    n = num_partitions * cardinality_partitions;
+    to_be_blocked = workspace->to_be_blocked;
+    list_blocked_nodes = open_node->list_blocked_nodes;
+    current_open_node = workspace->probe_node;
+    current_list_blocked_nodes = current_open_node->list_blocked_nodes;
+    MEWCP_copy_combinatorial_cache(open_node->combinatorial_cache,current_open_node->combinatorial_cache);
+
+    *out_num_fixed = 0;
+
+    /* As at the root, but each probe keeps the nodes already blocked in the open node */
+    for (k = 0; k<num_partitions; ++k)
+    {
+        for (i = k*cardinality_partitions; i <  (k*cardinality_partitions + cardinality_partitions); ++i)
+        {
+            to_be_blocked[i] = false;
+            if (list_blocked_nodes->bool_list[i] == true)
+            {
+                continue;
+            }
+
+            MEWCP_clone_list_blocked_modes(list_blocked_nodes,current_list_blocked_nodes,n);
+            for (j = k*cardinality_partitions; j < (k*cardinality_partitions + cardinality_partitions); ++j)
+            {
+                if (j != i)
+                {
+                    MEWCP_add_blocked_node(j,current_list_blocked_nodes);
+                }
+            }
+
+            current_open_node->DB = (double) MEWCP_MAX_DOUBLE;
+            current_open_node->PB = (double) MEWCP_MIN_DOUBLE;
+            MEWCP_bound_combinatorial(current_open_node,workspace,matrix_weights,num_partitions,cardinality_partitions,best_primal);
+
+            if ((best_primal - current_open_node->DB ) > MEWCP_EPSILON  )
+            {
+#if defined MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
+                printf("XXX Fixing (%d) node to be close! i: %d\t DB: %.2lf\n",open_node->serial_node,i,current_open_node->DB);
+#endif
+                to_be_blocked[i] = true;
+            }
+        }
+    }
+
+    /* The probes are done on the same blocked list, now I can change it */
+    for (i=0; i<n; ++i)
+    {
+        if (to_be_blocked[i] == true)
+        {
+            MEWCP_add_blocked_node(i,list_blocked_nodes);
+            *out_num_fixed += 1;
+        }
+    }
+
+    /* Each partition needs at least a free node */
+    for (k = 0; k<num_partitions; ++k)
+    {
+        num_free_nodes = 0;
+        for (i = k*cardinality_partitions; i <  (k*cardinality_partitions + cardinality_partitions); ++i)
+        {
+            if (list_blocked_nodes->bool_list[i] == false)
+            {
+                ++num_free_nodes;
+            }
+        }
+        if (num_free_nodes == 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+list_blocked_nodes_t * MEWCP_blocked_other_nodes_of_partition(const unsigned int pos,
+        const unsigned int partition,
+        const unsigned int num_partitions,
+        const unsigned int cardinality_partitions)
+{
+    unsigned int i;
+
+    list_blocked_nodes_t * list_blocked_nodes;
+    list_blocked_nodes = MEWCP_allocate_list_blocked_nodes(num_partitions*cardinality_partitions);
+
+    for (i = partition*cardinality_partitions; i < ( partition*cardinality_partitions + cardinality_partitions); ++i)
+    {
+        if (i != pos)
+        {
+
+            MEWCP_add_blocked_node(i,list_blocked_nodes);
+#if defined  MEWCP_COMBINATORIAL_PREPROCESSING_DEBUG
+
+            //printf("other node part: %d\tblocked: %d\n",partition,i);
+#endif
+
+        }
+    }
+
+
+
+    return list_blocked_nodes;
+
+}
+
+
+void MEWCP_bound_combinatorial(open_node_t * open_node,
+                               bound_workspace_t * workspace,
+                               matrix_weights_t * matrix_weights,
+                               const unsigned int num_partitions,
+                               const unsigned int cardinality_partitions,
+                               const double best_primal)
+{
+#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
+    printf("\n* MEWCP_bound_combinatorial *\n");
+#endif
+
+    unsigned int i,k,t,n;
+    double z_primal;
+    double sum_i;
+    double total_sum = 0;
+    bool * bool_list;
+    combinatorial_cache_t * cache;
+
+    /* Vector of selected nodes for each partition Vk, k=1,..,m */
+    int * selected_node = workspace->selected_node;
+    double * value_k = workspace->value_k;
+
+    /* Partitions with nodes blocked or freed since the cache was computed */
+    bool * newly_blocked = workspace->newly_blocked;
+    bool * newly_free = workspace->newly_free;
+
+    n = num_partitions * cardinality_partitions;
+    bool_list = open_node->list_blocked_nodes->bool_list;
+
+    if (open_node->combinatorial_cache == NULL)
+    {
+        open_node->combinatorial_cache = MEWCP_allocate_combinatorial_cache(n,num_partitions);
+    }
+    MEWCP_own_combinatorial_cache(&open_node->combinatorial_cache);
+    cache = open_node->combinatorial_cache;
+
+#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
+    printf("m: %d\tc: %d\n",num_partitions, cardinality_partitions);
+    MEWCP_print_list_blocked_nodes(open_node->list_blocked_nodes);
+#endif
+
+    for (t = 0; t<num_partitions; ++t)
+    {
+        newly_blocked[t] = false;
+        newly_free[t] = false;
+        for (i = cardinality_partitions*t; i< (cardinality_partitions*t +cardinality_partitions); ++i)
+        {
+            if ( (bool_list[i] == true) && (cache->blocked[i] == false) )
+            {
+                newly_blocked[t] = true;
+            }
+            if ( (bool_list[i] == false) && (cache->blocked[i] == true) )
+            {
+                newly_free[t] = true;
+            }
+        }
+    }
+
+    /* The best edge of i towards each partition is searched again only if it may have changed */
+    for (k = 0; k<num_partitions; ++k)
+    {
+        for (i = cardinality_partitions*k; i< (cardinality_partitions*k +cardinality_partitions); ++i)
+        {
+            if (bool_list[i] == true)
+            {
+                continue;
+            }
+
+            if (cache->blocked[i] == true)
+            {
+                /* Not in the cache, the whole row */
+                cache->node_values[i] = matrix_weights->weight[i][i];
+                for (t = 0; t<num_partitions; ++t)
+                {
+                    if (t != k)
+                    {
+                        cache->selected_edges[i*num_partitions + t] = -1;
+                        MEWCP_update_combinatorial_cache_edge(cache,matrix_weights,bool_list,i,t,num_partitions,cardinality_partitions);
+                    }
+                }
+                continue;
+            }
+
+            for (t = 0; t<num_partitions; ++t)
+            {
+                if (t == k)
+                {
+                    continue;
+                }
+                if ( (newly_free[t] == true) ||
+                     ( (newly_blocked[t] == true) && (cache->selected_edges[i*num_partitions + t] != -1) &&
+                       (bool_list[cache->selected_edges[i*num_partitions + t]] == true) ) )
+                {
+                    MEWCP_update_combinatorial_cache_edge(cache,matrix_weights,bool_list,i,t,num_partitions,cardinality_partitions);
+                }
+            }
+        }
+    }
+
+    memcpy(cache->blocked,bool_list,sizeof(bool)*n);
+
+    /* For each partition the best node */
+    for (k = 0; k<num_partitions; ++k)
+    {
+        sum_i = MEWCP_MIN_DOUBLE;
+        selected_node[k] = -1;
+        for (i = cardinality_partitions*k; i< (cardinality_partitions*k +cardinality_partitions); ++i)
+        {
+            if (bool_list[i] == true)
+            {
+                continue;
+            }
+            if ((cache->node_values[i] - sum_i) > MEWCP_EPSILON)
+            {
+                selected_node[k] = i;
+                sum_i = cache->node_values[i];
+            }
+        }
+        value_k[k] = sum_i;
+
+#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
+        printf("Partition:  k: %d \t taken nodo: %d\t value: %.2lf\n",k, selected_node[k],value_k[k]);
+#endif
+
+        if (selected_node[k] == -1)
+        {
+            /* No free node in the partition, there is no solution */
+            open_node->DB_comb = (double) MEWCP_MIN_DOUBLE;
+            open_node->DB = (double) MEWCP_MIN_DOUBLE;
+            return;
+        }
+    }
+
+
+    /* Now let's evaluate the value */
+    total_sum = 0;
+    for (i=0;i<num_partitions;++i)
+    {
+        total_sum += value_k[i];
+    }
+    total_sum = total_sum / 2;
+
+#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
+    /* Let's see nodes taken */
+
+    printf("Taken nodes: ");
+    for (i=0;i<num_partitions;++i)
+    {
+        printf("%d ",selected_node[i]);
+    }
+    printf("\n");
+#endif
+
+
+    z_primal = MEWCP_evaluate_list_nodes_solution(selected_node,matrix_weights,num_partitions);
 
 
 #if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
@@ -347,7 +855,8 @@ void MEWCP_bound_combinatorial(open_node_t * open_node,
 #endif
 
 #if defined ASSERT
-    assert((total_sum - z_primal) >= 0);
+    /* The taken nodes may be in conflict, the bound holds only for the solutions without conflicts */
+    assert(((total_sum - z_primal) >= 0) || (matrix_weights->conflict_start != NULL));
 #endif
     /* Update values DB PB */
 
@@ -362,7 +871,10 @@ void MEWCP_bound_combinatorial(open_node_t * open_node,
     if ( (z_primal - open_node->PB) > MEWCP_EPSILON )
     {
         open_node->PB = z_primal;
-        open_node->list_nodes_solution = MEWCP_allocate_list_nodes_solution(num_partitions);
+        if (open_node->list_nodes_solution == NULL)
+        {
+            open_node->list_nodes_solution = MEWCP_allocate_list_nodes_solution(num_partitions);
+        }
         MEWCP_clone_list_nodes_solution(selected_node,open_node->list_nodes_solution,num_partitions);
     }
 
@@ -370,3 +882,755 @@ void MEWCP_bound_combinatorial(open_node_t * open_node,
 }
 
 
+
+
+/* Best edge of the free node i towards the partition t, the term of i's value is replaced */
+void MEWCP_update_combinatorial_cache_edge(combinatorial_cache_t * cache, matrix_weights_t * matrix_weights, const bool * bool_list,
+        const unsigned int i, const unsigned int t,
+        const unsigned int num_partitions,
+        const unsigned int cardinality_partitions)
+{
+    int selected_j;
+    double sum_j;
+
+    selected_j = cache->selected_edges[i*num_partitions + t];
+    if (selected_j != -1)
+    {
+        cache->node_values[i] -= matrix_weights->weight[i][selected_j];
+        cache->node_values[i] -= (matrix_weights->weight[selected_j][selected_j])/(num_partitions -1);
+    }
+
+    selected_j = MEWCP_best_free_neighbour(matrix_weights,bool_list,i,t,num_partitions,cardinality_partitions,&sum_j);
+
+    cache->selected_edges[i*num_partitions + t] = selected_j;
+    if (selected_j != -1)
+    {
+        cache->node_values[i] += sum_j;
+    }
+}
+
+int MEWCP_best_free_neighbour(matrix_weights_t * matrix_weights, const bool * bool_list,
+                              const unsigned int i, const unsigned int t,
+                              const unsigned int num_partitions,
+                              const unsigned int cardinality_partitions,
+                              double * out_value)
+{
+    unsigned int j,r;
+    int * list_neighbours;
+    int selected_j;
+    double sum_j;
+    double sum_tmp;
+    unsigned int num_conflicts_i;
+
+    (void) MEWCP_get_node_conflicts(matrix_weights,i,&num_conflicts_i);
+
+    if (matrix_weights->sorted_neighbours != NULL)
+    {
+        /* The first free one is the best */
+        list_neighbours = &matrix_weights->sorted_neighbours[i*matrix_weights->n + t*cardinality_partitions];
+        for (r=0; r<cardinality_partitions; ++r)
+        {
+            j = list_neighbours[r];
+            if ( (bool_list[j] == false) && ( (num_conflicts_i == 0) || (MEWCP_is_conflict(matrix_weights,i,j) == false) ) )
+            {
+                *out_value = matrix_weights->weight[i][j] + (matrix_weights->weight[j][j])/(num_partitions -1);
+                return j;
+            }
+        }
+        *out_value = MEWCP_MIN_DOUBLE;
+        return -1;
+    }
+
+    sum_j = MEWCP_MIN_DOUBLE;
+    selected_j = -1;
+    for(j = cardinality_partitions*t ; j<(cardinality_partitions*t + cardinality_partitions); ++j)
+    {
+        if ( (bool_list[j] == true) || ( (num_conflicts_i > 0) && (MEWCP_is_conflict(matrix_weights,i,j) == true) ) )
+        {
+            continue;
+        }
+        /* I keep the maximum weight edge*/
+        sum_tmp = matrix_weights->weight[i][j];
+        sum_tmp += (matrix_weights->weight[j][j])/(num_partitions -1);
+
+        if ( (sum_tmp - sum_j) > MEWCP_EPSILON)
+        {
+            sum_j = sum_tmp;
+            selected_j = j;
+        }
+    }
+
+    *out_value = sum_j;
+    return selected_j;
+}
+
+
+int sort_compare_neighbours(const void * a, const void * b)
+{
+    const sorted_neighbour_t * neighbour_a = (const sorted_neighbour_t *) a;
+    const sorted_neighbour_t * neighbour_b = (const sorted_neighbour_t *) b;
+
+    /* Decreasing key, the first node among the equal ones as in the linear search */
+    if (neighbour_a->key > neighbour_b->key)
+    {
+        return -1;
+    }
+    if (neighbour_a->key < neighbour_b->key)
+    {
+        return 1;
+    }
+    return neighbour_a->node - neighbour_b->node;
+}
+
+
+void MEWCP_compute_sorted_neighbours(matrix_weights_t * matrix_weights)
+{
+    unsigned int i,j,t,r,n,m,c;
+    sorted_neighbour_t * list_tmp;
+
+    n = matrix_weights->n;
+    m = matrix_weights->m;
+    c = matrix_weights->c;
+
+    if ( (matrix_weights->sorted_neighbours != NULL) || (m < 2) )
+    {
+        return;
+    }
+
+    matrix_weights->sorted_neighbours = (int *) malloc(sizeof(int) * n * n);
+    list_tmp = (sorted_neighbour_t *) malloc(sizeof(sorted_neighbour_t) * c);
+    if ( (matrix_weights->sorted_neighbours == NULL) || (list_tmp == NULL) )
+    {
+        printf("!!! ERROR allocation sorted_neighbours! \n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i=0; i<n; ++i)
+    {
+        for (t=0; t<m; ++t)
+        {
+            for (r=0, j=t*c; r<c; ++r, ++j)
+            {
+                list_tmp[r].key = matrix_weights->weight[i][j] + (matrix_weights->weight[j][j])/(m -1);
+                list_tmp[r].node = j;
+            }
+            qsort(list_tmp, c, sizeof(sorted_neighbour_t), sort_compare_neighbours);
+            for (r=0; r<c; ++r)
+            {
+                matrix_weights->sorted_neighbours[i*n + t*c + r] = list_tmp[r].node;
+            }
+        }
+    }
+
+    free(list_tmp);
+}
+
+
+void MEWCP_free_sorted_neighbours(matrix_weights_t * matrix_weights)
+{
+    free(matrix_weights->sorted_neighbours);
+    matrix_weights->sorted_neighbours = NULL;
+}
+
+void MEWCP_free_conflicts(matrix_weights_t * matrix_weights)
+{
+    free(matrix_weights->conflict_start);
+    free(matrix_weights->conflict_nodes);
+    matrix_weights->conflict_start = NULL;
+    matrix_weights->conflict_nodes = NULL;
+    matrix_weights->num_conflicts = 0;
+}
+
+/* Best value of the pair of partitions (k,t): max over the free i of k and the free j of t of
+ * the edge plus the shares of the two vertex weights (each vertex weight is shared by its num_partitions-1 edges)
+ */
+double MEWCP_compute_pair_bound(open_node_t * open_node, matrix_weights_t * matrix_weights,
+                                const unsigned int k, const unsigned int t,
+                                const unsigned int num_partitions,
+                                const unsigned int cardinality_partitions)
+{
+    unsigned int i;
+    double best_value;
+    double value;
+    bool * bool_list;
+
+    bool_list = open_node->list_blocked_nodes->bool_list;
+    best_value = (double) MEWCP_MIN_DOUBLE;
+
+    for (i = k*cardinality_partitions; i < (k*cardinality_partitions + cardinality_partitions); ++i)
+    {
+        if (bool_list[i] == true)
+        {
+            continue;
+        }
+        if (MEWCP_best_free_neighbour(matrix_weights,bool_list,i,t,num_partitions,cardinality_partitions,&value) == -1)
+        {
+            continue;
+        }
+        value += (matrix_weights->weight[i][i])/(num_partitions -1);
+
+        if (value > best_value)
+        {
+            best_value = value;
+        }
+    }
+
+    return best_value;
+}
+
+
+void MEWCP_compute_pair_bounds(open_node_t * open_node, matrix_weights_t * matrix_weights,
+                               const unsigned int num_partitions,
+                               const unsigned int cardinality_partitions)
+{
+    unsigned int k;
+
+    if (num_partitions < 2)
+    {
+        return;	/* there are no pairs */
+    }
+
+    if (open_node->pair_bounds == NULL)
+    {
+        open_node->pair_bounds = MEWCP_allocate_pair_bounds(num_partitions);
+    }
+
+    for (k=0; k<num_partitions; ++k)
+    {
+        MEWCP_update_pair_bounds_partition(open_node,matrix_weights,k,num_partitions,cardinality_partitions);
+    }
+}
+
+
+void MEWCP_update_pair_bounds_partition(open_node_t * open_node, matrix_weights_t * matrix_weights,
+                                        const unsigned int partition,
+                                        const unsigned int num_partitions,
+                                        const unsigned int cardinality_partitions)
+{
+    unsigned int t;
+    double value;
+
+    if (open_node->pair_bounds == NULL)
+    {
+        return;
+    }
+
+    for (t=0; t<num_partitions; ++t)
+    {
+        if (t == partition)
+        {
+            continue;
+        }
+        value = MEWCP_compute_pair_bound(open_node,matrix_weights,partition,t,num_partitions,cardinality_partitions);
+        open_node->pair_bounds[partition*num_partitions + t] = value;
+        open_node->pair_bounds[t*num_partitions + partition] = value;
+    }
+}
+
+
+bool MEWCP_bound_trivial(open_node_t * open_node, const unsigned int num_partitions)
+{
+    unsigned int k,t;
+    double total_sum;
+
+    if (open_node->pair_bounds == NULL)
+    {
+        return false;
+    }
+
+    /* Any solution takes one edge per pair of partitions and each vertex weight once */
+    total_sum = 0;
+    for (k=0; k<num_partitions; ++k)
+    {
+        for (t=k+1; t<num_partitions; ++t)
+        {
+            if (open_node->pair_bounds[k*num_partitions + t] == (double) MEWCP_MIN_DOUBLE)
+            {
+                total_sum = (double) MEWCP_MIN_DOUBLE;	/* a partition has no free node */
+                break;
+            }
+            total_sum += open_node->pair_bounds[k*num_partitions + t];
+        }
+        if (total_sum == (double) MEWCP_MIN_DOUBLE)
+        {
+            break;
+        }
+    }
+
+#if defined MEWCP_BOUNDING_VERBOSE2
+
+    printf("(BB)  Bound Trivial: (%d) DB: %.2lf \t level: %u\n",open_node->serial_node, total_sum, open_node->depth_level);
+#endif
+
+    if ((open_node->DB - total_sum) > MEWCP_EPSILON )
+    {
+        open_node->DB = total_sum;
+    }
+
+    return true;
+}
+
+
+/* Lagrangian relaxation of the agreement of the edges: the node i of the partition k takes for each
+ * partition t its best edge towards a node j, paying back the multiplier of j towards k and earning
+ * its own multiplier towards t. For any multiplier the terms of a solution cancel out
+ */
+double MEWCP_evaluate_lagrangian(open_node_t * open_node, bound_workspace_t * workspace, matrix_weights_t * matrix_weights,
+                                 const unsigned int num_partitions,
+                                 const unsigned int cardinality_partitions)
+{
+    unsigned int i,j,k,t;
+    int selected_j;
+    double sum_j;
+    double sum_tmp;
+    double value;
+    double total_sum = 0;
+    unsigned int num_conflicts_i;
+    bool * bool_list = open_node->list_blocked_nodes->bool_list;
+    double * multipliers = open_node->lagrangian_multipliers->values;
+    int * selected_node = workspace->selected_node;
+    int * partners = workspace->partners;
+    double * value_k = workspace->value_k;
+
+    for (k = 0; k<num_partitions; ++k)
+    {
+        selected_node[k] = -1;
+        value_k[k] = MEWCP_MIN_DOUBLE;
+
+        for (i = cardinality_partitions*k; i< (cardinality_partitions*k +cardinality_partitions); ++i)
+        {
+            if (bool_list[i] == true)
+            {
+                continue;
+            }
+
+            value = matrix_weights->weight[i][i];
+            (void) MEWCP_get_node_conflicts(matrix_weights,i,&num_conflicts_i);
+            for (t = 0; t<num_partitions; ++t)
+            {
+                if (t == k)
+                {
+                    continue;
+                }
+
+                sum_j = MEWCP_MIN_DOUBLE;
+                selected_j = -1;
+                for (j = cardinality_partitions*t; j< (cardinality_partitions*t +cardinality_partitions); ++j)
+                {
+                    if ( (bool_list[j] == true) || ( (num_conflicts_i > 0) && (MEWCP_is_conflict(matrix_weights,i,j) == true) ) )
+                    {
+                        continue;
+                    }
+                    sum_tmp = matrix_weights->weight[i][j] + (matrix_weights->weight[j][j])/(num_partitions -1) - multipliers[j*num_partitions + k];
+                    if (sum_tmp > sum_j)
+                    {
+                        sum_j = sum_tmp;
+                        selected_j = j;
+                    }
+                }
+
+                partners[i*num_partitions + t] = selected_j;
+                if (selected_j == -1)
+                {
+                    /* i is in no solution */
+                    value = MEWCP_MIN_DOUBLE;
+                    break;
+                }
+                value += multipliers[i*num_partitions + t] + sum_j;
+            }
+
+            if (value > value_k[k])
+            {
+                value_k[k] = value;
+                selected_node[k] = i;
+            }
+        }
+
+        if (selected_node[k] == -1)
+        {
+            /* No node of the partition is in a solution */
+            return MEWCP_MIN_DOUBLE;
+        }
+        total_sum += value_k[k];
+    }
+
+    return total_sum / 2;
+}
+
+
+void MEWCP_bound_lagrangian(open_node_t * open_node,
+                            bound_workspace_t * workspace,
+                            matrix_weights_t * matrix_weights,
+                            const unsigned int num_partitions,
+                            const unsigned int cardinality_partitions,
+                            const double best_primal)
+{
+#if defined MEWCP_BOUNDING_COMBINATORIAL_DEBUG
+    printf("\n* MEWCP_bound_lagrangian *\n");
+#endif
+
+    unsigned int i,k,t,n;
+    unsigned int iteration;
+    unsigned int num_not_improving;
+    int j;
+    double bound;
+    double best_bound;
+    double z_primal;
+    double gap;
+    double norm;
+    double step;
+    double theta;
+    double * multipliers;
+    int * selected_node = workspace->selected_node;
+    int * partners = workspace->partners;
+    double * subgradient = workspace->subgradient;
+
+    n = num_partitions * cardinality_partitions;
+
+    if (open_node->lagrangian_multipliers == NULL)
+    {
+        open_node->lagrangian_multipliers = MEWCP_allocate_lagrangian_multipliers(n,num_partitions);
+    }
+    MEWCP_own_lagrangian_multipliers(&open_node->lagrangian_multipliers);
+    multipliers = open_node->lagrangian_multipliers->values;
+
+    best_bound = MEWCP_MAX_DOUBLE;
+    theta = MEWCP_LAGRANGIAN_STEP;
+    num_not_improving = 0;
+
+    for (iteration = 0; iteration < MEWCP_LAGRANGIAN_ITERATIONS; ++iteration)
+    {
+        bound = MEWCP_evaluate_lagrangian(open_node,workspace,matrix_weights,num_partitions,cardinality_partitions);
+        if (bound <= MEWCP_MIN_DOUBLE)
+        {
+            /* There is no solution */
+            open_node->DB = (double) MEWCP_MIN_DOUBLE;
+            return;
+        }
+
+        /* The taken nodes are a solution */
+        z_primal = MEWCP_evaluate_list_nodes_solution(selected_node,matrix_weights,num_partitions);
+        if ( (z_primal - open_node->PB) > MEWCP_EPSILON )
+        {
+            open_node->PB = z_primal;
+            if (open_node->list_nodes_solution == NULL)
+            {
+                open_node->list_nodes_solution = MEWCP_allocate_list_nodes_solution(num_partitions);
+            }
+            MEWCP_clone_list_nodes_solution(selected_node,open_node->list_nodes_solution,num_partitions);
+        }
+
+        /* The steps are not monotone, I keep the best multipliers */
+        if ( (best_bound - bound) > MEWCP_EPSILON )
+        {
+            best_bound = bound;
+            memcpy(workspace->best_multipliers,multipliers,sizeof(double)*n*num_partitions);
+            num_not_improving = 0;
+        }
+        else
+        {
+            num_not_improving++;
+            if (num_not_improving >= MEWCP_LAGRANGIAN_HALVING)
+            {
+                theta = theta / 2;
+                num_not_improving = 0;
+            }
+        }
+
+        if ( (best_primal - best_bound) > MEWCP_EPSILON )
+        {
+            /* The node will be closed */
+            break;
+        }
+
+        /* Subgradient: +1 for the taken node of k towards t, -1 for the node of k the taken node of t points to */
+        memset(subgradient,0,sizeof(double)*n*num_partitions);
+        for (k = 0; k<num_partitions; ++k)
+        {
+            for (t = 0; t<num_partitions; ++t)
+            {
+                if (t == k)
+                {
+                    continue;
+                }
+                subgradient[selected_node[k]*num_partitions + t] += 1;
+                j = partners[selected_node[t]*num_partitions + k];
+                subgradient[j*num_partitions + t] -= 1;
+            }
+        }
+
+        norm = 0;
+        for (i = 0; i<n*num_partitions; ++i)
+        {
+            norm += subgradient[i]*subgradient[i];
+        }
+        if (norm == 0)
+        {
+            /* The edges agree, the bound is the value of the taken nodes */
+            break;
+        }
+
+        /* Polyak step towards the best primal */
+        gap = bound - ((open_node->PB > best_primal) ? open_node->PB : best_primal);
+        if (gap < MEWCP_EPSILON)
+        {
+            gap = MEWCP_EPSILON;
+        }
+        step = theta * gap / norm;
+
+        for (i = 0; i<n*num_partitions; ++i)
+        {
+            multipliers[i] -= step * subgradient[i];
+        }
+    }
+
+    /* The sons start from the best multipliers */
+    memcpy(multipliers,workspace->best_multipliers,sizeof(double)*n*num_partitions);
+
+#if defined MEWCP_BOUNDING_VERBOSE1
+
+    printf("(BB)  Bound Lagrangian: (%d) DB: %.2lf \t PB: %.2lf \t iterations: %u \t level: %u\n",open_node->serial_node, best_bound, open_node->PB, iteration, open_node->depth_level);
+#endif
+
+    if ((open_node->DB - best_bound) > MEWCP_EPSILON )
+    {
+        open_node->DB = best_bound;
+    }
+}
+
+
+/*
+ * ALLOCATION FUNCTIONS
+ */
+
+double * MEWCP_allocate_pair_bounds(const unsigned int num_partitions)
+{
+    double * pair_bounds;
+
+    pair_bounds = (double *) calloc(num_partitions*num_partitions,sizeof(double));
+    if ( pair_bounds == NULL)
+    {
+        printf("!!! ERROR allocation pair_bounds! \n");
+        exit(EXIT_FAILURE);
+    }
+
+    return pair_bounds;
+}
+
+
+double * MEWCP_clone_pair_bounds(const double * pair_bounds, const unsigned int num_partitions)
+{
+    double * clone;
+
+    if (pair_bounds == NULL)
+    {
+        return NULL;
+    }
+
+    clone = MEWCP_allocate_pair_bounds(num_partitions);
+    memcpy(clone,pair_bounds,sizeof(double)*num_partitions*num_partitions);
+
+    return clone;
+}
+
+
+void MEWCP_free_pair_bounds(double * pair_bounds)
+{
+    free(pair_bounds);
+}
+
+
+lagrangian_multipliers_t * MEWCP_allocate_lagrangian_multipliers(const unsigned int num_nodes, const unsigned int num_partitions)
+{
+    lagrangian_multipliers_t * multipliers;
+
+    multipliers = (lagrangian_multipliers_t *) calloc(1,sizeof(lagrangian_multipliers_t));
+    if ( multipliers == NULL)
+    {
+        printf("!!! ERROR allocation lagrangian_multipliers! \n");
+        exit(EXIT_FAILURE);
+    }
+    multipliers->num_nodes = num_nodes;
+    multipliers->num_partitions = num_partitions;
+    multipliers->num_references = 1;
+
+    multipliers->values = (double *) calloc(num_nodes*num_partitions,sizeof(double));
+    if ( multipliers->values == NULL)
+    {
+        printf("!!! ERROR allocation lagrangian_multipliers! \n");
+        exit(EXIT_FAILURE);
+    }
+
+    return multipliers;
+}
+
+
+lagrangian_multipliers_t * MEWCP_clone_lagrangian_multipliers(const lagrangian_multipliers_t * multipliers)
+{
+    lagrangian_multipliers_t * clone;
+
+    if (multipliers == NULL)
+    {
+        return NULL;
+    }
+
+    clone = MEWCP_allocate_lagrangian_multipliers(multipliers->num_nodes,multipliers->num_partitions);
+    memcpy(clone->values,multipliers->values,sizeof(double)*multipliers->num_nodes*multipliers->num_partitions);
+
+    return clone;
+}
+
+
+lagrangian_multipliers_t * MEWCP_share_lagrangian_multipliers(lagrangian_multipliers_t * multipliers)
+{
+    if (multipliers != NULL)
+    {
+        __atomic_add_fetch(&multipliers->num_references, 1, __ATOMIC_RELAXED);
+    }
+    return multipliers;
+}
+
+
+void MEWCP_own_lagrangian_multipliers(lagrangian_multipliers_t ** multipliers)
+{
+    lagrangian_multipliers_t * clone;
+
+    if ( (*multipliers == NULL) || (__atomic_load_n(&(*multipliers)->num_references, __ATOMIC_ACQUIRE) == 1) )
+    {
+        return;
+    }
+
+    clone = MEWCP_clone_lagrangian_multipliers(*multipliers);
+    MEWCP_free_lagrangian_multipliers(*multipliers);
+    *multipliers = clone;
+}
+
+
+void MEWCP_free_lagrangian_multipliers(lagrangian_multipliers_t * multipliers)
+{
+    if (multipliers == NULL)
+    {
+        return;
+    }
+    if (__atomic_sub_fetch(&multipliers->num_references, 1, __ATOMIC_ACQ_REL) > 0)
+    {
+        return;
+    }
+    free(multipliers->values);
+    free(multipliers);
+}
+
+
+combinatorial_cache_t * MEWCP_allocate_combinatorial_cache(const unsigned int num_nodes, const unsigned int num_partitions)
+{
+    unsigned int i;
+    combinatorial_cache_t * cache;
+
+    cache = (combinatorial_cache_t *) calloc(1,sizeof(combinatorial_cache_t));
+    if ( cache == NULL)
+    {
+        printf("!!! ERROR allocation combinatorial_cache! \n");
+        exit(EXIT_FAILURE);
+    }
+    cache->num_nodes = num_nodes;
+    cache->num_partitions = num_partitions;
+    cache->num_references = 1;
+
+    cache->blocked = (bool *) calloc(num_nodes,sizeof(bool));
+    cache->selected_edges = (int *) calloc(num_nodes*num_partitions,sizeof(int));
+    cache->node_values = (double *) calloc(num_nodes,sizeof(double));
+    if ( (cache->blocked == NULL) || (cache->selected_edges == NULL) || (cache->node_values == NULL) )
+    {
+        printf("!!! ERROR allocation combinatorial_cache! \n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Nothing computed yet: every node is seen as blocked */
+    for (i=0; i<num_nodes; ++i)
+    {
+        cache->blocked[i] = true;
+    }
+
+    return cache;
+}
+
+
+combinatorial_cache_t * MEWCP_clone_combinatorial_cache(const combinatorial_cache_t * cache)
+{
+    combinatorial_cache_t * clone;
+
+    if (cache == NULL)
+    {
+        return NULL;
+    }
+
+    clone = MEWCP_allocate_combinatorial_cache(cache->num_nodes,cache->num_partitions);
+    memcpy(clone->blocked,cache->blocked,sizeof(bool)*cache->num_nodes);
+    memcpy(clone->selected_edges,cache->selected_edges,sizeof(int)*cache->num_nodes*cache->num_partitions);
+    memcpy(clone->node_values,cache->node_values,sizeof(double)*cache->num_nodes);
+
+    return clone;
+}
+
+
+void MEWCP_copy_combinatorial_cache(const combinatorial_cache_t * cache, combinatorial_cache_t * copy)
+{
+    unsigned int i;
+
+    if (cache == NULL)
+    {
+        /* Nothing computed */
+        for (i=0; i<copy->num_nodes; ++i)
+        {
+            copy->blocked[i] = true;
+        }
+        return;
+    }
+
+    memcpy(copy->blocked,cache->blocked,sizeof(bool)*cache->num_nodes);
+    memcpy(copy->selected_edges,cache->selected_edges,sizeof(int)*cache->num_nodes*cache->num_partitions);
+    memcpy(copy->node_values,cache->node_values,sizeof(double)*cache->num_nodes);
+}
+
+
+combinatorial_cache_t * MEWCP_share_combinatorial_cache(combinatorial_cache_t * cache)
+{
+    if (cache != NULL)
+    {
+        __atomic_add_fetch(&cache->num_references, 1, __ATOMIC_RELAXED);
+    }
+    return cache;
+}
+
+
+void MEWCP_own_combinatorial_cache(combinatorial_cache_t ** cache)
+{
+    combinatorial_cache_t * clone;
+
+    if ( (*cache == NULL) || (__atomic_load_n(&(*cache)->num_references, __ATOMIC_ACQUIRE) == 1) )
+    {
+        return;
+    }
+
+    /* The other nodes only read it */
+    clone = MEWCP_clone_combinatorial_cache(*cache);
+    MEWCP_free_combinatorial_cache(*cache);
+    *cache = clone;
+}
+
+
+void MEWCP_free_combinatorial_cache(combinatorial_cache_t * cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+    if (__atomic_sub_fetch(&cache->num_references, 1, __ATOMIC_ACQ_REL) > 0)
+    {
+        return;
+    }
+    free(cache->blocked);
+    free(cache->selected_edges);
+    free(cache->node_values);
+    free(cache);
+}
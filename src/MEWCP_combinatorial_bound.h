@@ -25,11 +25,51 @@
  * Prototypes 
  */
  
- void MEWCP_compute_combinatorial_preprocessing(open_node_t * open_node, matrix_weights_t * matrix_weights,
+ /* The n probes of the root are shared by num_threads workers, bound_workspaces has one workspace per worker */
+ void MEWCP_compute_combinatorial_preprocessing(open_node_t * open_node, bound_workspace_t * bound_workspaces,
+ 												matrix_weights_t * matrix_weights,
  												const unsigned int num_partitions,
  												const unsigned int cardinality_partitions,
- 												const double initial_best_primal);
+ 												const double initial_best_primal,
+ 												const unsigned int num_threads);
+
+ void MEWCP_run_preprocessing_workers(preprocessing_worker_t * preprocessing_workers, const unsigned int num_threads);
+ void * MEWCP_preprocessing_worker(void * arg);
+ void MEWCP_preprocessing_probe_node(preprocessing_worker_t * preprocessing_worker, const unsigned int i);
+ void MEWCP_update_preprocessing_best_primal(preprocessing_context_t * preprocessing_context, double primal);
+
+ /* The free nodes whose probe DB is below best_primal are added to the list, returns how many */
+ unsigned int MEWCP_block_preprocessing_probes(const double * vect_dual, const double best_primal,
+ 												list_blocked_nodes_t * list_blocked_nodes,
+ 												const unsigned int num_nodes);
+
+ /* The pairs of the MEWCP_CONFLICT_CANDIDATES free nodes with the lowest probe DB and the free nodes
+  * of the other partitions are probed, the ones below the best primal are added to the conflicts of matrix_weights.
+  * Returns the number of new conflicts
+  */
+ unsigned int MEWCP_compute_preprocessing_conflicts(preprocessing_worker_t * preprocessing_workers, const unsigned int num_threads,
+ 													sorted_neighbour_t * sorted_probes);
+ /* Probes the pairs of candidates[r] into the row r of new_conflicts */
+ void MEWCP_preprocessing_probe_pairs(preprocessing_worker_t * preprocessing_worker, const unsigned int r);
+ /* The rows of new_conflicts (num_candidates x n, row r for candidates[r]) are merged in the sorted rows
+  * of matrix_weights, both ways. Returns the number of new pairs
+  */
+ unsigned int MEWCP_add_conflicts(matrix_weights_t * matrix_weights, const int * candidates, const bool * new_conflicts,
+ 									const unsigned int num_candidates);
+ /* The pair of candidates[r] and j is set in new_conflicts, it is not a conflict yet and no earlier row has it */
+ bool MEWCP_is_new_conflict(const matrix_weights_t * matrix_weights, const int * candidates, const bool * new_conflicts,
+ 							const unsigned int r, const unsigned int j);
+ void MEWCP_free_conflicts(matrix_weights_t * matrix_weights);
  
+ /* Probing of the free nodes of an open node against best_primal, the nodes that can't be in a better
+  * solution are added to its blocked list. Returns false if a partition has no free node left
+  */
+ bool MEWCP_compute_combinatorial_fixing(open_node_t * open_node, bound_workspace_t * workspace, matrix_weights_t * matrix_weights,
+ 										const unsigned int num_partitions,
+ 										const unsigned int cardinality_partitions,
+ 										const double best_primal,
+ 										unsigned int * out_num_fixed);
+
  /* given a node position and its partition generates the list of blocked nodes consisting of other nodes of the same partition*/
 list_blocked_nodes_t * MEWCP_blocked_other_nodes_of_partition(const unsigned int pos, 
 																const unsigned int partition, 
@@ -37,16 +77,103 @@ list_blocked_nodes_t * MEWCP_blocked_other_nodes_of_partition(const unsigned int
 																const unsigned int cardinality_partitions);
 
  
+ /* The best edges of each free node are kept in open_node->combinatorial_cache, a node with the cache
+  * of its father searches again only the edges towards the partitions whose blocked nodes changed
+  */
  void MEWCP_bound_combinatorial(open_node_t * open_node,
+ 								bound_workspace_t * workspace,
  								matrix_weights_t * matrix_weights,
  								const unsigned int num_partitions,
  								const unsigned int cardinality_partitions,
  								const double best_primal);
+
+ void MEWCP_update_combinatorial_cache_edge(combinatorial_cache_t * cache, matrix_weights_t * matrix_weights, const bool * bool_list,
+ 										const unsigned int i, const unsigned int t,
+ 										const unsigned int num_partitions,
+ 										const unsigned int cardinality_partitions);
  								
  
  
+ /* Pair bounds: for each pair of partitions the best edge plus the shares of the vertex weights among the free
+  * nodes, stored in open_node->pair_bounds (num_partitions x num_partitions). A son updates only the pairs of the
+  * partition it was branched on
+  */
+ double MEWCP_compute_pair_bound(open_node_t * open_node, matrix_weights_t * matrix_weights,
+ 								const unsigned int k, const unsigned int t,
+ 								const unsigned int num_partitions,
+ 								const unsigned int cardinality_partitions);
+
+ void MEWCP_compute_pair_bounds(open_node_t * open_node, matrix_weights_t * matrix_weights,
+ 								const unsigned int num_partitions,
+ 								const unsigned int cardinality_partitions);
+
+ void MEWCP_update_pair_bounds_partition(open_node_t * open_node, matrix_weights_t * matrix_weights,
+ 										const unsigned int partition,
+ 										const unsigned int num_partitions,
+ 										const unsigned int cardinality_partitions);
+
+ /* O(m^2) bound, sum of the pair bounds. Weaker than the combinatorial bound. Returns false if
+  * the node has no pair bounds
+  */
+ bool MEWCP_bound_trivial(open_node_t * open_node, const unsigned int num_partitions);
+ 
+ /* matrix_weights->sorted_neighbours[i*n + t*c + r] is the r-th node j of the partition t by decreasing
+  * w_ij + w_jj/(m-1). Built once per instance in O(n^2 log c)
+  */
+ void MEWCP_compute_sorted_neighbours(matrix_weights_t * matrix_weights);
+ void MEWCP_free_sorted_neighbours(matrix_weights_t * matrix_weights);
+ int sort_compare_neighbours(const void * a, const void * b);
+
+ /* Best free j of the partition t for the node i (-1 if none) and its value w_ij + w_jj/(m-1),
+  * the nodes in conflict with i are skipped */
+ int MEWCP_best_free_neighbour(matrix_weights_t * matrix_weights, const bool * bool_list,
+ 								const unsigned int i, const unsigned int t,
+ 								const unsigned int num_partitions,
+ 								const unsigned int cardinality_partitions,
+ 								double * out_value);
+
+ /* Lagrangian bound: the multipliers of open_node->lagrangian_multipliers->values[i*m + t] (those of the father, or zero)
+  * are tightened by at most MEWCP_LAGRANGIAN_ITERATIONS subgradient steps and the best ones are kept for the sons.
+  * With zero multipliers it is the combinatorial bound
+  */
+ void MEWCP_bound_lagrangian(open_node_t * open_node,
+ 								bound_workspace_t * workspace,
+ 								matrix_weights_t * matrix_weights,
+ 								const unsigned int num_partitions,
+ 								const unsigned int cardinality_partitions,
+ 								const double best_primal);
+
+ /* Bound with the current multipliers, the taken nodes are in workspace->selected_node and the best edges
+  * in workspace->partners. MEWCP_MIN_DOUBLE if a partition has no node in a solution
+  */
+ double MEWCP_evaluate_lagrangian(open_node_t * open_node, bound_workspace_t * workspace, matrix_weights_t * matrix_weights,
+ 								const unsigned int num_partitions,
+ 								const unsigned int cardinality_partitions);
+
  /*
  * ALLOCATION FUNCTIONS 
  */
+ 
+ double * MEWCP_allocate_pair_bounds(const unsigned int num_partitions);
+ double * MEWCP_clone_pair_bounds(const double * pair_bounds, const unsigned int num_partitions);
+ void MEWCP_free_pair_bounds(double * pair_bounds);
+ 
+ lagrangian_multipliers_t * MEWCP_allocate_lagrangian_multipliers(const unsigned int num_nodes, const unsigned int num_partitions);
+ lagrangian_multipliers_t * MEWCP_clone_lagrangian_multipliers(const lagrangian_multipliers_t * multipliers);
+ /* Shared and copied on write like the combinatorial cache */
+ lagrangian_multipliers_t * MEWCP_share_lagrangian_multipliers(lagrangian_multipliers_t * multipliers);
+ void MEWCP_own_lagrangian_multipliers(lagrangian_multipliers_t ** multipliers);
+ void MEWCP_free_lagrangian_multipliers(lagrangian_multipliers_t * multipliers);
+ 
+ combinatorial_cache_t * MEWCP_allocate_combinatorial_cache(const unsigned int num_nodes, const unsigned int num_partitions);
+ combinatorial_cache_t * MEWCP_clone_combinatorial_cache(const combinatorial_cache_t * cache);
+ void MEWCP_copy_combinatorial_cache(const combinatorial_cache_t * cache, combinatorial_cache_t * copy);	/* cache NULL: empty copy */
+
+ /* One more reference to the cache (read only), NULL stays NULL */
+ combinatorial_cache_t * MEWCP_share_combinatorial_cache(combinatorial_cache_t * cache);
+ /* Before writing: a cache shared with other nodes is replaced by a copy of its own */
+ void MEWCP_own_combinatorial_cache(combinatorial_cache_t ** cache);
+ /* Drops a reference, the last one frees the cache */
+ void MEWCP_free_combinatorial_cache(combinatorial_cache_t * cache);
 
 #endif /*MEWCP_COMBINATORIAL_BOUND_H_*/
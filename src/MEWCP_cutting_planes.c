@@ -0,0 +1,892 @@
+/*****************************************************************************
+ *  Project: Maximum Edge Weighted Clique Problem with multiple choice contraints
+ *
+ *  Authors:
+ *  (c) 2009 Yari Melzani (yari.melzani@gmail.com)
+ *
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <memory.h>
+#include <math.h>
+
+#include "MEWCP_cutting_planes.h"
+#include "MEWCP_combinatorial_bound.h"
+#include "MEWCP_dsdp.h"
+#include "dsdp/dsdp5.h"
+
+
+double MEWCP_bound_cutting_planes(open_node_t * open_node, bound_workspace_t * workspace, cut_pool_t * cut_pool,
+                                  constraint_t * constraints_matrix, double * bi,
+                                  const unsigned int num_constraints,
+                                  const unsigned int num_nodes,
+                                  const double DB,
+                                  const double best_PB,
+                                  SDPCone * node_sdpcone,
+                                  sdp_reduction_t * reduction)
+{
+#if defined MEWCP_BOUNDING_DEBUG
+    printf("* MEWCP_bound_cutting_planes *\n");
+#endif
+
+    unsigned int round;
+    unsigned int num_node_cuts;
+    unsigned int num_new_cuts;
+    unsigned int num_start_y;
+    unsigned int num_variables;
+    unsigned int i;
+    sdp_cut_t * node_cuts = workspace->node_cuts;
+    constraint_t * cut_constraints = workspace->cut_constraints;	/* the matrices of node_cuts given to DSDP */
+    double * cut_rhs = workspace->cut_rhs;		/* and their rhs */
+    double * cut_y = workspace->cut_y;		/* y of the last round, the start of the next one */
+    double * sol_X;
+    double * buffer_X;		/* X of all the nodes for a reduced problem */
+
+    DSDP dsdp;
+    DSDP previous_dsdp;	/* owns sol_X after the first round */
+    SDPCone sdpcone;
+    DSDPTerminationReason reason;
+    int iterations;
+    double dobj;
+    double cut_DB;
+    double best_DB;
+    bool go_on;
+
+    /* The cuts of all the rounds stay in the problem, DSDP keeps the pointers to their matrices */
+    buffer_X = NULL;
+    if (reduction != NULL)
+    {
+        buffer_X = workspace->buffer_X;
+    }
+    sol_X = MEWCP_get_node_X(node_sdpcone, reduction, buffer_X);
+
+    num_variables = MEWCP_get_sdp_num_variables(reduction, num_constraints);
+    num_node_cuts = 0;
+    num_start_y = 0;
+    best_DB = DB;
+    previous_dsdp = NULL;
+    go_on = true;
+
+    for (round = 0; (round < MEWCP_CUT_ROUNDS) && (go_on == true); ++round)
+    {
+        num_new_cuts = MEWCP_separate_cuts(cut_pool, sol_X, node_cuts, num_node_cuts, node_cuts + num_node_cuts, workspace->cut_support,
+                                           &workspace->cut_family_matrix);
+
+        /* sol_X is no more needed */
+        if (previous_dsdp != NULL)
+        {
+            DSDPDestroy(previous_dsdp);
+            previous_dsdp = NULL;
+        }
+
+        /* A cut restricted to nothing can't enter the problem */
+        i = num_node_cuts;
+        while (i < num_node_cuts + num_new_cuts)
+        {
+            MEWCP_get_cut_constraint(cut_pool, reduction, &node_cuts[i], &cut_constraints[i], &cut_rhs[i], &workspace->cut_family_matrix);
+            if (cut_constraints[i].num_nz == 0)
+            {
+                num_new_cuts -= 1;
+                node_cuts[i] = node_cuts[num_node_cuts + num_new_cuts];
+                continue;
+            }
+            ++i;
+        }
+        if (num_new_cuts == 0)
+        {
+            break;
+        }
+        num_node_cuts += num_new_cuts;
+
+        dsdp = MEWCP_create_sdp_cut_problem(open_node, constraints_matrix, bi, num_constraints, num_nodes, reduction,
+                                            node_cuts, cut_constraints, cut_rhs, num_node_cuts, cut_y, num_start_y, best_PB, &sdpcone);
+        DSDPSolve(dsdp);
+        DSDPGetIts(dsdp, &iterations);
+        DSDPStopReason(dsdp, &reason);
+        DSDPGetDObjective(dsdp, &dobj);
+        open_node->sdp_iterations += iterations;
+        __atomic_add_fetch(&cut_pool->number_rounds, 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&cut_pool->number_cuts, num_new_cuts, __ATOMIC_RELAXED);
+
+        /* The dual objective is a valid bound only if DSDP has ended well */
+        cut_DB = -dobj + MEWCP_get_sdp_fixed_value(reduction);
+        go_on = false;
+        if ( ((reason == DSDP_CONVERGED) || (reason == DSDP_UPPERBOUND)) && ((best_DB - cut_DB) > MEWCP_EPSILON) )
+        {
+            __atomic_add_fetch(&cut_pool->number_improved, 1, __ATOMIC_RELAXED);
+            go_on = ((best_DB - cut_DB) > MEWCP_CUT_MIN_IMPROVEMENT * fabs(cut_DB));
+            best_DB = cut_DB;
+
+            if ((best_DB - best_PB) <= MEWCP_EPSILON)
+            {
+                __atomic_add_fetch(&cut_pool->number_closed, 1, __ATOMIC_RELAXED);
+                go_on = false;
+            }
+            else
+            {
+                /* The rounding and the branching go on from the X with the cuts */
+                DSDPComputeX(dsdp);
+                MEWCP_dump_node_diag_X(&sdpcone, reduction, open_node->diagX, num_nodes);
+                sol_X = MEWCP_get_node_X(&sdpcone, reduction, buffer_X);
+                DSDPGetY(dsdp, cut_y, num_variables + num_node_cuts);
+                num_start_y = num_variables + num_node_cuts;
+            }
+        }
+
+#if defined MEWCP_BOUNDING_VERBOSE1
+        printf("(BB)  Cuts: (%d) round: %u \t cuts: %u \t DB: %.2lf \t Status: %d\n",open_node->serial_node, round, num_node_cuts, cut_DB, reason);
+#endif
+
+        if (go_on == true)
+        {
+            previous_dsdp = dsdp;
+        }
+        else
+        {
+            DSDPDestroy(dsdp);
+        }
+    }
+
+    if (previous_dsdp != NULL)
+    {
+        DSDPDestroy(previous_dsdp);
+    }
+
+    return best_DB;
+}
+
+DSDP MEWCP_create_sdp_cut_problem(open_node_t * open_node,
+                                  constraint_t * constraints_matrix, double * bi,
+                                  const unsigned int num_constraints,
+                                  const unsigned int num_nodes,
+                                  sdp_reduction_t * reduction,
+                                  sdp_cut_t * node_cuts,
+                                  constraint_t * cut_constraints,
+                                  double * cut_rhs,
+                                  const unsigned int num_node_cuts,
+                                  double * start_y,
+                                  const unsigned int num_start_y,
+                                  const double best_PB,
+                                  SDPCone * out_sdpcone)
+{
+    unsigned int i;
+    unsigned int var;
+    unsigned int num_variables;
+    unsigned int num_inequalities;
+    DSDP dsdp;
+    SDPCone sdpcone;
+    BCone bcone;
+
+    num_variables = MEWCP_get_sdp_num_variables(reduction, num_constraints);
+    DSDPCreate(num_variables + num_node_cuts, &dsdp);
+    DSDPCreateSDPCone(dsdp, NUM_BLOCKS, &sdpcone);
+    SDPConeSetBlockSize(sdpcone, 0, MEWCP_get_sdp_block_size(reduction, num_nodes));
+
+    /* W, the families and the branching matrix as in MEWCP_bound, with the y of the node without cuts */
+    MEWCP_load_sdp_node_problem(dsdp, sdpcone, open_node, constraints_matrix, bi, num_constraints, num_nodes, reduction);
+
+    num_inequalities = 0;
+    for (i=0; i<num_node_cuts; ++i)
+    {
+        if (node_cuts[i].is_inequality == true)
+        {
+            ++num_inequalities;
+        }
+    }
+    bcone = NULL;
+    if (num_inequalities > 0)
+    {
+        /* A slack of the constraint in (P) is an upper bound of its y in (D) */
+        DSDPCreateBCone(dsdp, &bcone);
+        BConeAllocateBounds(bcone, num_inequalities);
+    }
+
+    /* The y of the last round replace the ones of the node, the new cuts start from 0 */
+    for (i=0; i<num_start_y; ++i)
+    {
+        DSDPSetY0(dsdp, i+1, start_y[i]);
+    }
+
+    /* The cuts follow */
+    for (i=0; i<num_node_cuts; ++i)
+    {
+        var = num_variables + 1 + i;
+        DSDPSetDualObjective(dsdp, var, cut_rhs[i]);
+        SDPConeSetASparseVecMat(sdpcone, 0, var, MEWCP_get_sdp_block_size(reduction, num_nodes), MEWCP_ALPHA, 0,
+                                cut_constraints[i].index, cut_constraints[i].weight, cut_constraints[i].num_nz);
+        if (node_cuts[i].is_inequality == true)
+        {
+            BConeSetPSlackVariable(bcone, var);
+        }
+    }
+
+    DSDPSetGapTolerance(dsdp,MEWCP_GAP_TOLERANCE);
+    DSDPSetPotentialParameter(dsdp,MEWCP_POTENTIAL_PARAMETER);
+    DSDPReuseMatrix(dsdp,MEWCP_REUSE_MATRIX);
+    DSDPSetPNormTolerance(dsdp,MEWCP_SET_PNORM_TOLERANCE);
+
+    /* I stop the computation when DD is greater to -best_PB, the fixed nodes are not in the SDP */
+    DSDPSetDualBound(dsdp, -(best_PB - MEWCP_get_sdp_fixed_value(reduction)));
+
+    DSDPSetup(dsdp);
+
+    *out_sdpcone = sdpcone;
+    return dsdp;
+}
+
+void MEWCP_get_cut_constraint(cut_pool_t * cut_pool, sdp_reduction_t * reduction, sdp_cut_t * cut, constraint_t * out_constraint,
+                              double * out_rhs, constraint_t * family_matrix)
+{
+    constraint_t * matrix;
+    double constant;
+
+    *out_rhs = cut->rhs;
+
+    /* Without reduction the matrix goes straight into the room of the cut */
+    matrix = (reduction == NULL) ? out_constraint : family_matrix;
+    if (cut->type >= MEWCP_CUT_CARDINALITY)
+    {
+        MEWCP_write_family_cut_matrix(cut_pool, cut, matrix);
+    }
+    else
+    {
+        memcpy(matrix->index, cut->index, cut->num_nz*sizeof(int));
+        memcpy(matrix->weight, cut->weight, cut->num_nz*sizeof(double));
+        matrix->num_nz = cut->num_nz;
+    }
+
+    if (reduction == NULL)
+    {
+        return;
+    }
+
+    out_constraint->num_nz = MEWCP_restrict_packed_matrix(reduction, matrix->index, matrix->weight, matrix->num_nz,
+                             out_constraint->index, out_constraint->weight, &constant);
+    *out_rhs -= constant;
+}
+
+unsigned int MEWCP_separate_cuts(cut_pool_t * cut_pool, double * sol_X,
+                                 sdp_cut_t * node_cuts,
+                                 const unsigned int num_node_cuts,
+                                 sdp_cut_t * out_cuts,
+                                 sorted_neighbour_t * support,
+                                 constraint_t * family_matrix)
+{
+    unsigned int i;
+    unsigned int num_selected;
+    sdp_cut_t * cut;
+
+    num_selected = 0;
+
+    /* The pool first: its cuts are checked and aged, the ones too old are dropped */
+    pthread_mutex_lock(&cut_pool->mutex);
+    i = 0;
+    while (i < cut_pool->num_cuts)
+    {
+        cut = &cut_pool->cuts[i];
+        if (MEWCP_find_cut(cut, node_cuts, num_node_cuts) == false)
+        {
+            cut->violation = MEWCP_evaluate_cut(cut_pool, cut, sol_X, family_matrix);
+            if (cut->violation > MEWCP_CUT_VIOLATION)
+            {
+                cut->age = 0;
+                MEWCP_offer_cut(cut, node_cuts, num_node_cuts, out_cuts, &num_selected);
+            }
+            else
+            {
+                cut->age += 1;
+                if (cut->age > MEWCP_CUT_MAX_AGE)
+                {
+                    cut_pool->num_cuts -= 1;
+                    cut_pool->cuts[i] = cut_pool->cuts[cut_pool->num_cuts];
+                    continue;
+                }
+            }
+        }
+        ++i;
+    }
+    pthread_mutex_unlock(&cut_pool->mutex);
+
+    /* The full separation only if the pool is not enough */
+    if (num_selected < MEWCP_CUTS_PER_ROUND)
+    {
+        MEWCP_separate_family_cuts(cut_pool, sol_X, node_cuts, num_node_cuts, out_cuts, &num_selected, family_matrix);
+        MEWCP_separate_triangle_cuts(cut_pool, sol_X, node_cuts, num_node_cuts, out_cuts, &num_selected, support);
+    }
+
+    MEWCP_add_cuts_to_pool(cut_pool, out_cuts, num_selected);
+
+    return num_selected;
+}
+
+void MEWCP_separate_family_cuts(cut_pool_t * cut_pool, double * sol_X,
+                                sdp_cut_t * node_cuts,
+                                const unsigned int num_node_cuts,
+                                sdp_cut_t * out_cuts,
+                                unsigned int * num_selected,
+                                constraint_t * family_matrix)
+{
+    int type;
+    unsigned int h;
+    unsigned int family_size;
+    sdp_cut_t cut;
+
+    for (type=MEWCP_CUT_CARDINALITY; type<MEWCP_CUT_TYPES; ++type)
+    {
+        if (cut_pool->is_family_separated[type] == false)
+        {
+            continue;
+        }
+
+        family_size = MEWCP_get_family_size(cut_pool, type);
+        for (h=0; h<family_size; ++h)
+        {
+            if (MEWCP_set_family_cut(cut_pool, &cut, type, h) == false)
+            {
+                continue;
+            }
+            cut.violation = MEWCP_evaluate_cut(cut_pool, &cut, sol_X, family_matrix);
+            if (cut.violation > MEWCP_CUT_VIOLATION)
+            {
+                MEWCP_offer_cut(&cut, node_cuts, num_node_cuts, out_cuts, num_selected);
+            }
+        }
+    }
+}
+
+unsigned int MEWCP_get_family_size(cut_pool_t * cut_pool, const int type)
+{
+    switch (type)
+    {
+    case MEWCP_CUT_CARDINALITY:
+        return 1;
+    case MEWCP_CUT_IMPROVED_MC_B:
+        return cut_pool->num_nodes * cut_pool->num_partitions;
+    case MEWCP_CUT_IMPROVED_MC_C:
+        return cut_pool->num_partitions;
+    case MEWCP_CUT_4C3_A:
+    case MEWCP_CUT_4C3_B:
+        return cut_pool->num_nodes;
+    }
+    return 0;
+}
+
+bool MEWCP_set_family_cut(cut_pool_t * cut_pool, sdp_cut_t * cut, const int type, const unsigned int h)
+{
+    unsigned int c;
+
+    c = cut_pool->num_nodes / cut_pool->num_partitions;
+
+    memset(cut, 0, sizeof(sdp_cut_t));
+    cut->type = type;
+    cut->nodes[0] = -1;
+    cut->nodes[1] = -1;
+    cut->nodes[2] = -1;
+    cut->is_inequality = false;
+    cut->rhs = 0.0;
+
+    switch (type)
+    {
+    case MEWCP_CUT_CARDINALITY:
+        cut->rhs = (double) cut_pool->num_partitions;
+        break;
+    case MEWCP_CUT_IMPROVED_MC_B:
+        /* h = v*m + u, u is not the partition of v */
+        cut->nodes[0] = h / cut_pool->num_partitions;
+        cut->nodes[1] = h % cut_pool->num_partitions;
+        if ((unsigned int) cut->nodes[0] / c == (unsigned int) cut->nodes[1])
+        {
+            return false;
+        }
+        break;
+    case MEWCP_CUT_IMPROVED_MC_C:
+        cut->nodes[1] = h;
+        break;
+    case MEWCP_CUT_4C3_A:
+        cut->nodes[0] = h;
+        break;
+    case MEWCP_CUT_4C3_B:
+        cut->nodes[0] = h;
+        cut->rhs = (double) cut_pool->num_partitions;
+        break;
+    }
+    return true;
+}
+
+void MEWCP_write_family_cut_matrix(cut_pool_t * cut_pool, sdp_cut_t * cut, constraint_t * out_matrix)
+{
+    int n,m,c;
+    int i,j;
+    int v,u;
+    int num_nz;
+
+    n = cut_pool->num_nodes;
+    m = cut_pool->num_partitions;
+    c = n / m;
+    v = cut->nodes[0];
+    u = cut->nodes[1];
+
+    /* The same elements of converter_dsdp.c, an off diagonal weight counts twice in A.X */
+    num_nz = 0;
+    switch (cut->type)
+    {
+    case MEWCP_CUT_CARDINALITY:
+        for (i=0; i<n; ++i)
+        {
+            out_matrix->index[num_nz] = MEWCP_packed_position(i,i);
+            out_matrix->weight[num_nz++] = 1.0;
+        }
+        break;
+    case MEWCP_CUT_IMPROVED_MC_B:
+        out_matrix->index[num_nz] = MEWCP_packed_position(v,v);
+        out_matrix->weight[num_nz++] = -1.0;
+        for (i=u*c; i<(u+1)*c; ++i)
+        {
+            out_matrix->index[num_nz] = MEWCP_packed_position(v,i);
+            out_matrix->weight[num_nz++] = 0.5;
+        }
+        break;
+    case MEWCP_CUT_IMPROVED_MC_C:
+        for (j=u*c; j<(u+1)*c; ++j)
+        {
+            for (i=u*c; i<j; ++i)
+            {
+                out_matrix->index[num_nz] = MEWCP_packed_position(j,i);
+                out_matrix->weight[num_nz++] = 1.0;
+            }
+        }
+        break;
+    case MEWCP_CUT_4C3_A:
+        out_matrix->index[num_nz] = MEWCP_packed_position(v,v);
+        out_matrix->weight[num_nz++] = 1.0 - m;
+        for (j=0; j<n; ++j)
+        {
+            if (j / c != v / c)
+            {
+                out_matrix->index[num_nz] = MEWCP_packed_position(v,j);
+                out_matrix->weight[num_nz++] = 0.5;
+            }
+        }
+        break;
+    case MEWCP_CUT_4C3_B:
+        for (j=0; j<n; ++j)
+        {
+            out_matrix->index[num_nz] = MEWCP_packed_position(j,j);
+            out_matrix->weight[num_nz++] = (j == v) ? (double) m : 1.0;
+        }
+        for (j=0; j<n; ++j)
+        {
+            if (j / c != v / c)
+            {
+                out_matrix->index[num_nz] = MEWCP_packed_position(v,j);
+                out_matrix->weight[num_nz++] = -0.5;
+            }
+        }
+        break;
+    }
+    out_matrix->num_nz = num_nz;
+}
+
+void MEWCP_separate_triangle_cuts(cut_pool_t * cut_pool, double * sol_X,
+                                  sdp_cut_t * node_cuts,
+                                  const unsigned int num_node_cuts,
+                                  sdp_cut_t * out_cuts,
+                                  unsigned int * num_selected,
+                                  sorted_neighbour_t * support)
+{
+    unsigned int a,b,h;
+    unsigned int num_support;
+    int i,j,k;
+    double violation;
+    sdp_cut_t cut;
+
+    /* A node with X_ii near 0 has its row near 0 too, its inequalities can't be violated */
+    num_support = 0;
+    for (a=0; a<cut_pool->num_nodes; ++a)
+    {
+        if (sol_X[MEWCP_packed_position(a,a)] > MEWCP_CUT_VIOLATION)
+        {
+            support[num_support].key = sol_X[MEWCP_packed_position(a,a)];
+            support[num_support].node = a;
+            ++num_support;
+        }
+    }
+    qsort(support, num_support, sizeof(sorted_neighbour_t), sort_compare_neighbours);
+    if (num_support > MEWCP_CUT_TRIANGLE_NODES)
+    {
+        num_support = MEWCP_CUT_TRIANGLE_NODES;
+    }
+
+    for (a=0; a<num_support; ++a)
+    {
+        i = support[a].node;
+        for (b=0; b<num_support; ++b)
+        {
+            j = support[b].node;
+            if (i == j)
+            {
+                continue;
+            }
+
+            violation = sol_X[MEWCP_packed_position(i,j)] - sol_X[MEWCP_packed_position(i,i)];
+            if (violation > MEWCP_CUT_VIOLATION)
+            {
+                MEWCP_build_triangle_cut(&cut, MEWCP_CUT_DIAGONAL, i, j, -1);
+                cut.violation = violation;
+                MEWCP_offer_cut(&cut, node_cuts, num_node_cuts, out_cuts, num_selected);
+            }
+
+            if (i > j)
+            {
+                continue;
+            }
+
+            violation = -sol_X[MEWCP_packed_position(i,j)];
+            if (violation > MEWCP_CUT_VIOLATION)
+            {
+                MEWCP_build_triangle_cut(&cut, MEWCP_CUT_NONNEGATIVE, i, j, -1);
+                cut.violation = violation;
+                MEWCP_offer_cut(&cut, node_cuts, num_node_cuts, out_cuts, num_selected);
+            }
+
+            violation = sol_X[MEWCP_packed_position(i,i)] + sol_X[MEWCP_packed_position(j,j)] - sol_X[MEWCP_packed_position(i,j)] - 1.0;
+            if (violation > MEWCP_CUT_VIOLATION)
+            {
+                MEWCP_build_triangle_cut(&cut, MEWCP_CUT_PAIR, i, j, -1);
+                cut.violation = violation;
+                MEWCP_offer_cut(&cut, node_cuts, num_node_cuts, out_cuts, num_selected);
+            }
+
+            for (h=0; h<num_support; ++h)
+            {
+                k = support[h].node;
+                if ((k == i) || (k == j))
+                {
+                    continue;
+                }
+                violation = sol_X[MEWCP_packed_position(i,k)] + sol_X[MEWCP_packed_position(j,k)] -
+                            sol_X[MEWCP_packed_position(i,j)] - sol_X[MEWCP_packed_position(k,k)];
+                if (violation > MEWCP_CUT_VIOLATION)
+                {
+                    MEWCP_build_triangle_cut(&cut, MEWCP_CUT_TRIANGLE, i, j, k);
+                    cut.violation = violation;
+                    MEWCP_offer_cut(&cut, node_cuts, num_node_cuts, out_cuts, num_selected);
+                }
+            }
+        }
+    }
+}
+
+void MEWCP_offer_cut(sdp_cut_t * cut, sdp_cut_t * node_cuts, const unsigned int num_node_cuts,
+                     sdp_cut_t * out_cuts, unsigned int * num_selected)
+{
+    unsigned int i;
+    unsigned int least_violated;
+
+    least_violated = 0;
+    if (*num_selected == MEWCP_CUTS_PER_ROUND)
+    {
+        for (i=1; i<MEWCP_CUTS_PER_ROUND; ++i)
+        {
+            if (out_cuts[i].violation < out_cuts[least_violated].violation)
+            {
+                least_violated = i;
+            }
+        }
+        if (cut->violation <= out_cuts[least_violated].violation)
+        {
+            return;
+        }
+    }
+
+    if ( (MEWCP_find_cut(cut, node_cuts, num_node_cuts) == true) ||
+            (MEWCP_find_cut(cut, out_cuts, *num_selected) == true) )
+    {
+        return;
+    }
+
+    if (*num_selected < MEWCP_CUTS_PER_ROUND)
+    {
+        out_cuts[*num_selected] = *cut;
+        *num_selected += 1;
+    }
+    else
+    {
+        out_cuts[least_violated] = *cut;
+    }
+}
+
+void MEWCP_add_cuts_to_pool(cut_pool_t * cut_pool, sdp_cut_t * cuts, const unsigned int num_cuts)
+{
+    unsigned int i,j;
+    unsigned int oldest;
+
+    pthread_mutex_lock(&cut_pool->mutex);
+    for (i=0; i<num_cuts; ++i)
+    {
+        if (MEWCP_find_cut(&cuts[i], cut_pool->cuts, cut_pool->num_cuts) == true)
+        {
+            continue;
+        }
+
+        cuts[i].age = 0;
+        if (cut_pool->num_cuts < MEWCP_CUT_POOL_SIZE)
+        {
+            cut_pool->cuts[cut_pool->num_cuts] = cuts[i];
+            cut_pool->num_cuts += 1;
+        }
+        else
+        {
+            oldest = 0;
+            for (j=1; j<cut_pool->num_cuts; ++j)
+            {
+                if (cut_pool->cuts[j].age > cut_pool->cuts[oldest].age)
+                {
+                    oldest = j;
+                }
+            }
+            cut_pool->cuts[oldest] = cuts[i];
+        }
+    }
+    pthread_mutex_unlock(&cut_pool->mutex);
+}
+
+bool MEWCP_is_same_cut(sdp_cut_t * cut_a, sdp_cut_t * cut_b)
+{
+    return (cut_a->type == cut_b->type) && (cut_a->nodes[0] == cut_b->nodes[0]) &&
+           (cut_a->nodes[1] == cut_b->nodes[1]) && (cut_a->nodes[2] == cut_b->nodes[2]);
+}
+
+bool MEWCP_find_cut(sdp_cut_t * cut, sdp_cut_t * cuts, const unsigned int num_cuts)
+{
+    unsigned int i;
+
+    for (i=0; i<num_cuts; ++i)
+    {
+        if (MEWCP_is_same_cut(cut, &cuts[i]) == true)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+double MEWCP_evaluate_cut(cut_pool_t * cut_pool, sdp_cut_t * cut, double * sol_X, constraint_t * family_matrix)
+{
+    double value;
+
+    if (cut->type >= MEWCP_CUT_CARDINALITY)
+    {
+        MEWCP_write_family_cut_matrix(cut_pool, cut, family_matrix);
+        value = MEWCP_evaluate_packed_matrix(family_matrix->index, family_matrix->weight, family_matrix->num_nz, cut_pool->is_diagonal, sol_X);
+    }
+    else
+    {
+        value = MEWCP_evaluate_packed_matrix(cut->index, cut->weight, cut->num_nz, cut_pool->is_diagonal, sol_X);
+    }
+
+    if (cut->is_inequality == true)
+    {
+        return value - cut->rhs;
+    }
+    return fabs(value - cut->rhs);
+}
+
+double MEWCP_evaluate_packed_matrix(const int * index, const double * weight, const int num_nz,
+                                    const bool * is_diagonal, double * sol_X)
+{
+    int p;
+    double value;
+
+    value = 0.0;
+    for (p=0; p<num_nz; ++p)
+    {
+        if (is_diagonal[index[p]] == true)
+        {
+            value += weight[p] * sol_X[index[p]];
+        }
+        else
+        {
+            value += 2.0 * weight[p] * sol_X[index[p]];
+        }
+    }
+    return value;
+}
+
+void MEWCP_build_triangle_cut(sdp_cut_t * cut, const int type, const int i, const int j, const int k)
+{
+    memset(cut, 0, sizeof(sdp_cut_t));
+    cut->type = type;
+    cut->nodes[0] = i;
+    cut->nodes[1] = j;
+    cut->nodes[2] = k;
+    cut->is_inequality = true;
+    cut->rhs = 0.0;
+
+    /* An off diagonal weight counts twice in A.X */
+    switch (type)
+    {
+    case MEWCP_CUT_NONNEGATIVE:
+        MEWCP_set_cut_element(cut, i, j, -0.5);
+        break;
+    case MEWCP_CUT_DIAGONAL:
+        MEWCP_set_cut_element(cut, i, j, 0.5);
+        MEWCP_set_cut_element(cut, i, i, -1.0);
+        break;
+    case MEWCP_CUT_PAIR:
+        MEWCP_set_cut_element(cut, i, i, 1.0);
+        MEWCP_set_cut_element(cut, j, j, 1.0);
+        MEWCP_set_cut_element(cut, i, j, -0.5);
+        cut->rhs = 1.0;
+        break;
+    case MEWCP_CUT_TRIANGLE:
+        MEWCP_set_cut_element(cut, i, k, 0.5);
+        MEWCP_set_cut_element(cut, j, k, 0.5);
+        MEWCP_set_cut_element(cut, i, j, -0.5);
+        MEWCP_set_cut_element(cut, k, k, -1.0);
+        break;
+    }
+}
+
+void MEWCP_set_cut_element(sdp_cut_t * cut, const int i, const int j, const double weight)
+{
+    int p;
+    int position;
+
+#if defined ASSERT
+    assert(cut->num_nz < MEWCP_CUT_MAX_NZ);
+#endif
+
+    position = MEWCP_packed_position(i,j);
+    for (p=cut->num_nz; (p > 0) && (cut->index[p-1] > position); --p)
+    {
+        cut->index[p] = cut->index[p-1];
+        cut->weight[p] = cut->weight[p-1];
+    }
+    cut->index[p] = position;
+    cut->weight[p] = weight;
+    cut->num_nz += 1;
+}
+
+unsigned int MEWCP_packed_position(const int i, const int j)
+{
+    if (i >= j)
+    {
+        return MEWCP_convert_coords_ij_to_vector_matrix(i+1,j+1);
+    }
+    return MEWCP_convert_coords_ij_to_vector_matrix(j+1,i+1);
+}
+
+cut_pool_t * MEWCP_allocate_cut_pool(const unsigned int num_nodes, const unsigned int num_partitions,
+                                     const bool c_cardinality,
+                                     const bool c_improved_MC_B, const bool c_improved_MC_C,
+                                     const bool c_4C3_A,
+                                     const bool c_4C3_B)
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_allocate_cut_pool *\n");
+#endif
+
+    unsigned int i;
+    unsigned int c;
+    unsigned int family_nz;
+    int type;
+    cut_pool_t * cut_pool;
+
+    cut_pool = (cut_pool_t *) calloc(1, sizeof(cut_pool_t));
+    if ( cut_pool == NULL)
+    {
+        printf("!!! ERROR allocation cut_pool! \n");
+        exit(EXIT_FAILURE);
+    }
+
+    c = num_nodes / num_partitions;
+    cut_pool->num_nodes = num_nodes;
+    cut_pool->num_partitions = num_partitions;
+    cut_pool->is_family_separated[MEWCP_CUT_CARDINALITY] = c_cardinality;
+    cut_pool->is_family_separated[MEWCP_CUT_IMPROVED_MC_B] = c_improved_MC_B;
+    cut_pool->is_family_separated[MEWCP_CUT_IMPROVED_MC_C] = c_improved_MC_C;
+    cut_pool->is_family_separated[MEWCP_CUT_4C3_A] = c_4C3_A;
+    cut_pool->is_family_separated[MEWCP_CUT_4C3_B] = c_4C3_B;
+
+    /* The largest matrix is the one of a family cut, or the one of a triangle inequality */
+    cut_pool->max_nz = MEWCP_CUT_MAX_NZ;
+    cut_pool->num_candidates = 0;
+    for (type=MEWCP_CUT_CARDINALITY; type<MEWCP_CUT_TYPES; ++type)
+    {
+        if (cut_pool->is_family_separated[type] == false)
+        {
+            continue;
+        }
+
+        cut_pool->num_candidates += MEWCP_get_family_size(cut_pool, type);
+        switch (type)
+        {
+        case MEWCP_CUT_CARDINALITY:
+            family_nz = num_nodes;
+            break;
+        case MEWCP_CUT_IMPROVED_MC_B:
+            /* no cut on the partition of the node */
+            cut_pool->num_candidates -= num_nodes;
+            family_nz = 1 + c;
+            break;
+        case MEWCP_CUT_IMPROVED_MC_C:
+            family_nz = c*(c-1)/2;
+            break;
+        case MEWCP_CUT_4C3_A:
+            family_nz = 1 + num_nodes - c;
+            break;
+        default:
+            family_nz = 2*num_nodes - c;
+            break;
+        }
+        if (family_nz > cut_pool->max_nz)
+        {
+            cut_pool->max_nz = family_nz;
+        }
+    }
+
+    cut_pool->is_diagonal = (bool *) calloc(num_nodes*(num_nodes+1)/2, sizeof(bool));
+    if ( cut_pool->is_diagonal == NULL)
+    {
+        printf("!!! ERROR allocation cut_pool->is_diagonal! \n");
+        exit(EXIT_FAILURE);
+    }
+    for (i=0; i<num_nodes; ++i)
+    {
+        cut_pool->is_diagonal[MEWCP_packed_position(i,i)] = true;
+    }
+
+    cut_pool->cuts = (sdp_cut_t *) calloc(MEWCP_CUT_POOL_SIZE, sizeof(sdp_cut_t));
+    if ( cut_pool->cuts == NULL)
+    {
+        printf("!!! ERROR allocation cut_pool->cuts! \n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_mutex_init(&cut_pool->mutex, NULL);
+
+    return cut_pool;
+}
+
+void MEWCP_free_cut_pool(cut_pool_t * cut_pool)
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_free_cut_pool *\n");
+#endif
+
+    pthread_mutex_destroy(&cut_pool->mutex);
+    free(cut_pool->is_diagonal);
+    free(cut_pool->cuts);
+    free(cut_pool);
+}
+
+void MEWCP_print_cut_pool(cut_pool_t * cut_pool)
+{
+    printf("Cutting planes:\n");
+    printf("\tCandidates: %u \t pool: %u\n", cut_pool->num_candidates, cut_pool->num_cuts);
+    printf("\tRounds: %u \t cuts: %u \t improved: %u \t closed: %u\n", cut_pool->number_rounds, cut_pool->number_cuts,
+           cut_pool->number_improved, cut_pool->number_closed);
+}
@@ -0,0 +1,136 @@
+#ifndef MEWCP_CUTTING_PLANES_H_
+#define MEWCP_CUTTING_PLANES_H_
+/*****************************************************************************
+ *  Project: Maximum Edge Weighted Clique Problem with multiple choice contraints
+ *
+ *  Authors:
+ *  (c) 2009 Yari Melzani (yari.melzani@gmail.com)
+ *
+ ****************************************************************************/
+
+#include "MEWCP_dsdp.h"
+
+
+/*
+ * Prototypes
+ */
+
+/* Rounds of separation and solve with the cuts of the node, node_sdpcone has the X of its SDP bound DB
+ * (restricted to the free nodes if reduction is not NULL). Returns the tightened DB, diagX and
+ * sdp_iterations of the node are updated. The cuts and the buffers are the ones of the workspace
+ */
+double MEWCP_bound_cutting_planes(open_node_t * open_node, bound_workspace_t * workspace, cut_pool_t * cut_pool,
+								constraint_t * constraints_matrix, double * bi,
+								const unsigned int num_constraints,
+								const unsigned int num_nodes,
+								const double DB,
+								const double best_PB,
+								SDPCone * node_sdpcone,
+								sdp_reduction_t * reduction);
+
+/* The DSDP problem of the node (as in MEWCP_bound, not solved) with the cuts after its constraints,
+ * cut_constraints and cut_rhs are their matrices and rhs. The inequalities get a slack variable in (P).
+ * The first num_start_y variables start from start_y, the y of the last round
+ */
+DSDP MEWCP_create_sdp_cut_problem(open_node_t * open_node,
+								constraint_t * constraints_matrix, double * bi,
+								const unsigned int num_constraints,
+								const unsigned int num_nodes,
+								sdp_reduction_t * reduction,
+								sdp_cut_t * node_cuts,
+								constraint_t * cut_constraints,
+								double * cut_rhs,
+								const unsigned int num_node_cuts,
+								double * start_y,
+								const unsigned int num_start_y,
+								const double best_PB,
+								SDPCone * out_sdpcone);
+
+/* Matrix and rhs of the cut for DSDP, written into the room of out_constraint. It is restricted to the free nodes
+ * if reduction is not NULL (the rhs without the part of the fixed nodes), family_matrix is the room of the full one
+ */
+void MEWCP_get_cut_constraint(cut_pool_t * cut_pool, sdp_reduction_t * reduction, sdp_cut_t * cut, constraint_t * out_constraint,
+								double * out_rhs, constraint_t * family_matrix);
+
+/* Puts in out_cuts (room for MEWCP_CUTS_PER_ROUND) the most violated cuts not among node_cuts:
+ * first from the pool, then from the families and the triangles. Returns their number,
+ * support has room for the num_nodes of the pool and family_matrix for its max_nz
+ */
+unsigned int MEWCP_separate_cuts(cut_pool_t * cut_pool, double * sol_X,
+								sdp_cut_t * node_cuts,
+								const unsigned int num_node_cuts,
+								sdp_cut_t * out_cuts,
+								sorted_neighbour_t * support,
+								constraint_t * family_matrix);
+
+/* The constraints of the separated families, each one written in family_matrix and checked on X */
+void MEWCP_separate_family_cuts(cut_pool_t * cut_pool, double * sol_X,
+								sdp_cut_t * node_cuts,
+								const unsigned int num_node_cuts,
+								sdp_cut_t * out_cuts,
+								unsigned int * num_selected,
+								constraint_t * family_matrix);
+
+/* Number of the cuts of the family, some of them may not exist (see MEWCP_set_family_cut) */
+unsigned int MEWCP_get_family_size(cut_pool_t * cut_pool, const int type);
+/* The h-th cut of the family, false if there is no such cut */
+bool MEWCP_set_family_cut(cut_pool_t * cut_pool, sdp_cut_t * cut, const int type, const unsigned int h);
+/* The packed matrix of a family cut, out_matrix has room for max_nz of the pool */
+void MEWCP_write_family_cut_matrix(cut_pool_t * cut_pool, sdp_cut_t * cut, constraint_t * out_matrix);
+
+/* The triangle inequalities among the nodes with the largest X_ii */
+void MEWCP_separate_triangle_cuts(cut_pool_t * cut_pool, double * sol_X,
+								sdp_cut_t * node_cuts,
+								const unsigned int num_node_cuts,
+								sdp_cut_t * out_cuts,
+								unsigned int * num_selected,
+								sorted_neighbour_t * support);
+
+/* Keeps the cut among the selected ones if it is new and among the MEWCP_CUTS_PER_ROUND most violated */
+void MEWCP_offer_cut(sdp_cut_t * cut, sdp_cut_t * node_cuts, const unsigned int num_node_cuts,
+								sdp_cut_t * out_cuts, unsigned int * num_selected);
+
+/* The cuts not in the pool are added, the oldest ones make room */
+void MEWCP_add_cuts_to_pool(cut_pool_t * cut_pool, sdp_cut_t * cuts, const unsigned int num_cuts);
+
+bool MEWCP_is_same_cut(sdp_cut_t * cut_a, sdp_cut_t * cut_b);
+bool MEWCP_find_cut(sdp_cut_t * cut, sdp_cut_t * cuts, const unsigned int num_cuts);
+
+/* Violation of the cut by X, negative if an inequality is satisfied. The matrix of a family cut is written in family_matrix */
+double MEWCP_evaluate_cut(cut_pool_t * cut_pool, sdp_cut_t * cut, double * sol_X, constraint_t * family_matrix);
+
+/* A.X of a packed matrix, the off diagonal elements count twice */
+double MEWCP_evaluate_packed_matrix(const int * index, const double * weight, const int num_nz,
+								const bool * is_diagonal, double * sol_X);
+
+/* Triangle inequality of the given type on the nodes i, j (and k) */
+void MEWCP_build_triangle_cut(sdp_cut_t * cut, const int type, const int i, const int j, const int k);
+
+/* Adds the element (i,j) to the packed matrix of the cut, kept sorted by position */
+void MEWCP_set_cut_element(sdp_cut_t * cut, const int i, const int j, const double weight);
+
+/* Position of (i,j) in the packed matrix, i and j = 0,...,n-1 in any order */
+unsigned int MEWCP_packed_position(const int i, const int j);
+
+
+/*
+ * ALLOCATION FUNCTIONS
+ */
+
+/* The pool separates the families with their flag set */
+cut_pool_t * MEWCP_allocate_cut_pool(const unsigned int num_nodes, const unsigned int num_partitions,
+								const bool c_cardinality,
+								const bool c_improved_MC_B, const bool c_improved_MC_C,
+								const bool c_4C3_A,
+								const bool c_4C3_B);
+
+/*
+ * FREE FUNCTIONS
+ */
+
+void MEWCP_free_cut_pool(cut_pool_t * cut_pool);
+
+void MEWCP_print_cut_pool(cut_pool_t * cut_pool);
+
+
+#endif /*MEWCP_CUTTING_PLANES_H_*/
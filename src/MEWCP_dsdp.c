@@ -6,6 +6,8 @@
  *
  ****************************************************************************/
 
+/* clock_gettime with -std=c99 */
+#define _POSIX_C_SOURCE 200112L
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -14,10 +16,12 @@
 #include <memory.h>
 #include <time.h>
 #include <sys/times.h>
+#include <math.h>
 
 #include "converter_dsdp.h"
 #include "MEWCP_explicit_enumeration.h"
 #include "MEWCP_combinatorial_bound.h"
+#include "MEWCP_cutting_planes.h"
 #include "MEWCP_tabu.h"
 #include "MEWCP_dsdp.h"
 #include "dsdp/dsdp5.h"
@@ -29,30 +33,26 @@ solution_bb_t * MEWCP_branch_and_bound(open_node_t * open_root_node, constraint_
                                        const unsigned int num_nodes,
                                        const unsigned int num_partitions,
                                        double best_primal_obj,
-                                       int * list_node_best_solution, double time_limit)
+                                       int * list_node_best_solution, double time_limit,
+                                       bb_parameters_t * bb_parameters,
+                                       cut_pool_t * cut_pool)
 {
 
 #if defined MEWCP_CONVERTER_DSDP_VERBOSE1
     printf("* MEWCP_branch_and_bound\n\tHere we goooooooooooooo!!!! *\n");
 #endif
 
+    unsigned int i;
     unsigned int cardinality_partitions;
     bool new_best_PB_found;
-    bool active_combinatorial_bound = false;
 
     list_branching_t * list_branching;
+    open_node_t * open_node;
 
-    /* Branching variables */
-    open_node_t * son_left;
-    open_node_t * son_right;
-    branching_open_node_t * branching_open_worst_bound;
-    open_node_t * open_node_worst_bound;
-    bool possible_branch;
+    /* B&B workers */
+    bb_context_t bb_context;
+    bb_worker_t * bb_workers;
 
-    float gap; /* is the current % gap */
-    bool left_to_be_closed;
-    bool right_to_be_closed;
-    
     double time_tmp = 0;  //useful to take time
 
     cardinality_partitions = num_nodes/num_partitions;
@@ -69,22 +69,63 @@ solution_bb_t * MEWCP_branch_and_bound(open_node_t * open_root_node, constraint_
     list_branching->best_primal = best_primal_obj;
     MEWCP_clone_list_nodes_solution(list_node_best_solution,list_branching->list_nodes_best_solution, num_partitions);
 
+    /* The context is shared by all the workers */
+    bb_context.list_branching = list_branching;
+    bb_context.bb_parameters = bb_parameters;
+    bb_context.constraints_matrix = constraints_matrix;
+    bb_context.matrix_weigths = matrix_weigths;
+    bb_context.bi = bi;
+    bb_context.num_constraints = num_constraints;
+    bb_context.dim_matrix = dim_matrix;
+    bb_context.num_nodes = num_nodes;
+    bb_context.num_partitions = num_partitions;
+    bb_context.cardinality_partitions = cardinality_partitions;
+    bb_context.time_limit = time_limit;
+    bb_context.time_start_cpu = get_cpu_time();
+    bb_context.time_start_wall = get_wall_time();
+    bb_context.pseudo_costs = NULL;
+    if (bb_parameters->branching_rule == MEWCP_BRANCHING_PSEUDO_COST)
+    {
+        bb_context.pseudo_costs = MEWCP_allocate_pseudo_costs(num_nodes);
+    }
+    bb_context.cut_pool = cut_pool;
+    bb_context.bound_policy = NULL;
+#if defined BOUND_POLICY_ACTIVE
+    bb_context.bound_policy = MEWCP_allocate_bound_policy();
+#endif
+
+#if defined SORTED_NEIGHBOURS_ACTIVE
+    /* Before the preprocessing, its probes use them too */
+    MEWCP_compute_sorted_neighbours(matrix_weigths);
+#endif
+
+    /* Each worker has its own SDP problem and bound workspace, the root is bounded by the first one */
+    bb_context.bound_workspaces = MEWCP_allocate_bound_workspaces(bb_parameters->num_threads,num_nodes,num_partitions,constraints_matrix,num_constraints,cut_pool);
+    bb_workers = MEWCP_allocate_bb_workers(&bb_context);
+    bb_context.bb_workers = bb_workers;
+
 
     /* Let's consider root node */
 
 #if defined PREPROCESSING_ACTIVE
     /* COMBINATORIAL PREPROCESSING */
-    MEWCP_compute_combinatorial_preprocessing(open_root_node,matrix_weigths,num_partitions,cardinality_partitions,list_branching->best_primal);
+    MEWCP_compute_combinatorial_preprocessing(open_root_node,bb_context.bound_workspaces,matrix_weigths,num_partitions,cardinality_partitions,list_branching->best_primal,bb_parameters->num_threads);
 
     /* Now the root node has been modified with a new list of blocked nodes and a related
      * brancing constraint 
      */
 #endif // combinatorial preprocessing
 
-    /* Explicit Enumeration */
-    if ( MEWCP_is_node_little_enough(open_root_node->list_blocked_nodes,num_partitions,num_nodes/num_partitions,MEWCP_MAX_EXPLICIT_SOLUTIONS) == true)
+#if defined TRIVIAL_BOUND_ACTIVE
+    /* The sons inherit the pair bounds of the root */
+    MEWCP_compute_pair_bounds(open_root_node,matrix_weigths,num_partitions,cardinality_partitions);
+    MEWCP_bound_trivial(open_root_node,num_partitions);
+#endif
+
+    /* Explicit Enumeration: the workers are idle, they share the root */
+    if ( MEWCP_is_root_explicit(open_root_node->list_blocked_nodes,bb_workers[0].workspace,num_partitions,num_nodes/num_partitions,bb_parameters->num_threads) == true)
     {
-        MEWCP_bound_explicit(open_root_node,matrix_weigths,num_partitions,num_nodes/num_partitions);
+        MEWCP_bound_explicit_parallel(open_root_node,bb_context.bound_workspaces,bb_parameters->num_threads,matrix_weigths,num_partitions,num_nodes/num_partitions,list_branching->best_primal);
 
         // I update the best valueif needed
         new_best_PB_found = MEWCP_is_new_best_PB_and_update(open_root_node,list_branching,num_partitions);
@@ -104,7 +145,7 @@ solution_bb_t * MEWCP_branch_and_bound(open_node_t * open_root_node, constraint_
         // Combinatorial BOUND
         
         time_tmp = get_cpu_time();  // I take the time in order to determine how long the combinatorial bounding takes
-        MEWCP_bound_combinatorial(open_root_node,matrix_weigths,num_partitions,num_nodes/num_partitions,list_branching->best_primal);
+        MEWCP_bound_combinatorial(open_root_node,bb_workers[0].workspace,matrix_weigths,num_partitions,num_nodes/num_partitions,list_branching->best_primal);
         new_best_PB_found = MEWCP_is_new_best_PB_and_update(open_root_node,list_branching,num_partitions);
 		
 		// I set the root DB due to combinatorial
@@ -123,8 +164,23 @@ solution_bb_t * MEWCP_branch_and_bound(open_node_t * open_root_node, constraint_
         //end combinatorial Bound
 #endif // end combinatorial bound condition
 
+#if defined LAGRANGIAN_BOUND_ACTIVE
+        /* The sons start from the multipliers of the root */
+        MEWCP_bound_lagrangian(open_root_node,bb_workers[0].workspace,matrix_weigths,num_partitions,num_nodes/num_partitions,list_branching->best_primal);
+        new_best_PB_found = MEWCP_is_new_best_PB_and_update(open_root_node,list_branching,num_partitions);
+
+#if defined MEWCP_DSDP_VERBOSE1
+
+        if( new_best_PB_found  == true)
+        {
+            printf("\t*****(Lagrangian Bound)  Node: %d\tNew best PB: %.2lf\n",open_root_node->serial_node,open_root_node->PB );
+        }
+#endif
+#endif
+
         /* Semidefinite BOUND */
-        MEWCP_bound(open_root_node,constraints_matrix,matrix_weigths, bi,num_constraints, dim_matrix, num_nodes,num_partitions, list_branching->best_primal);
+        MEWCP_bound(open_root_node,bb_workers[0].workspace,constraints_matrix,matrix_weigths, bi,num_constraints, dim_matrix, num_nodes,num_partitions, list_branching->best_primal,bb_context.cut_pool);
+        MEWCP_update_sdp_statistics(list_branching,open_root_node);
         new_best_PB_found = MEWCP_is_new_best_PB_and_update(open_root_node,list_branching,num_partitions);
 		
 		// I set the root DB due to semidefinite
@@ -145,6 +201,9 @@ solution_bb_t * MEWCP_branch_and_bound(open_node_t * open_root_node, constraint_
 
 
 
+    open_root_node->is_bounded = true;
+    open_root_node->fixing_best_primal = best_primal_obj;
+
 	/* gathering some root informations */
     solution_bb->DB_root = open_root_node->DB;
     solution_bb->PB_root_bestK = list_branching->best_primal;
@@ -154,1321 +213,3408 @@ solution_bb_t * MEWCP_branch_and_bound(open_node_t * open_root_node, constraint_
 
     /* Let's start! */
 
-    MEWCP_push_open_node(open_root_node,list_branching);
+    if (bb_parameters->scheduler == MEWCP_SCHEDULER_STEALING)
+    {
+        /* The first worker starts diving, the others will steal from it */
+        MEWCP_push_open_node(open_root_node,bb_workers[0].local_list);
+        list_branching->number_pending_nodes = 1;
+        list_branching->number_open_nodes = 1;
+    }
+    else
+    {
+        MEWCP_push_open_node(open_root_node,list_branching);
+    }
 
 
 
     /* All done, I'm ready to start with branching procedure */
 
-
-    while(MEWCP_is_list_branching_empty(list_branching) == false)
+#if !defined ROOT_NODE_SIMULATION_ONLY
+    if (bb_parameters->num_threads == 1)
     {
-    	#if defined ROOT_NODE_SIMULATION_ONLY
-    	// I only want the root simulation... i break!
-    	break;
-    	#endif
-    	
-    	if ((get_cpu_time() - time_limit) > MEWCP_EPSILON)
-    	{
-    		//Time limit exceeded
-    		#if defined MEWCP_DSDP_VERBOSE1
-    		printf("\n**************\tTime limit reached!\t****************\n\n");
-    		#endif
-    		solution_bb->best_bound_left = open_root_node->DB;
-    		break;
-    	}
-
-
-        branching_open_worst_bound = MEWCP_find_worst_bound_element(list_branching);
-        open_node_worst_bound = MEWCP_pop_specific_open_node(branching_open_worst_bound,list_branching);
-
-
-        if ( (open_node_worst_bound->DB - list_branching->best_primal) > MEWCP_EPSILON )
+        /* No need of threads, the only worker is me */
+        MEWCP_bb_worker(&bb_workers[0]);
+    }
+    else
+    {
+        for (i=0; i<bb_parameters->num_threads; ++i)
         {
+            if (pthread_create(&bb_workers[i].thread, NULL, MEWCP_bb_worker, &bb_workers[i]) != 0)
+            {
+                printf("!!! ERROR creation of B&B worker %u! \n",i);
+                exit(EXIT_FAILURE);
+            }
+        }
 
-            gap = (open_node_worst_bound->DB - list_branching->best_primal)/list_branching->best_primal * 100;
-#if defined MEWCP_DSDP_VERBOSE1
-
-            printf("\n++ Current DB(%d): %.2lf \t level: %u \tBest P(%d): %.2lf \t open_nodes: %d\t explored: %u \t gap: %.3f %%\n",open_node_worst_bound->serial_node,open_node_worst_bound->DB, open_node_worst_bound->depth_level, list_branching->serial_node_best_primal,list_branching->best_primal, list_branching->number_open_nodes, list_branching->number_explored_nodes,gap);
+        for (i=0; i<bb_parameters->num_threads; ++i)
+        {
+            pthread_join(bb_workers[i].thread, NULL);
+        }
+    }
 #endif
 
-            possible_branch = MEWCP_branch(open_node_worst_bound,dim_matrix,num_nodes,num_partitions,num_constraints,open_node_worst_bound->depth_level, &list_branching->current_serial_number, &son_left,&son_right);
 
+    /* The workers have given back the sons of the nodes they were processing,
+     * so the open nodes left are the whole frontier
+     */
+    if (list_branching->time_limit_reached == true)
+    {
+        solution_bb->best_bound_left = MEWCP_bb_compute_global_bound(&bb_context);
+    }
 
+    while (MEWCP_is_list_branching_empty(list_branching) == false)
+    {
+        open_node = MEWCP_pop_open_node(list_branching);
+        MEWCP_free_open_node(open_node);
+    }
+    for (i=0; i<bb_parameters->num_threads; ++i)
+    {
+        while ( (bb_workers[i].local_list != NULL) && (MEWCP_is_list_branching_empty(bb_workers[i].local_list) == false) )
+        {
+            open_node = MEWCP_pop_open_node(bb_workers[i].local_list);
+            MEWCP_free_open_node(open_node);
+        }
+    }
 
-            if (possible_branch == true)
-            {
 
-                /* I decide wether the node has to be closed */
-                left_to_be_closed = false;
-                right_to_be_closed = false;
+    /* Before I leave I'd let you know the best solution */
+#if defined MEWCP_DSDP_VERBOSE2
 
-#if defined COMBINATORIAL_BOUND_ACTIVE
-                /* I want to know if combinatorial bound was convinient on the father */
-                if( ((open_node_worst_bound->DB_SDP - open_node_worst_bound->DB_comb) > MEWCP_EPSILON) && open_node_worst_bound->DB_comb != 0)
-                {
-                    active_combinatorial_bound = true;
-#if defined  MEWCP_DSDP_VERBOSE2
 
-                    printf("combinatorial ACTIVE\t DB_SDP= %.2lf\t DB_comb= %.2lf\n", open_node_worst_bound->DB_SDP,open_node_worst_bound->DB_comb);
+    printf("\nBranch & Bound Z*: %.2lf\tExplored_nodes: %d\t Best node: %d\t\n",list_branching->best_primal,list_branching->number_explored_nodes, list_branching->serial_node_best_primal);
 #endif
+#if defined MEWCP_DSDP_VERBOSE2
 
-                }
-                else
-                {
-                    active_combinatorial_bound = false;
-#if defined  MEWCP_DSDP_VERBOSE2
-
-                    printf("combinatorial NOT active\t  DB_SDP= %.2lf\t DB_comb= %.2lf\n",open_node_worst_bound->DB_SDP,open_node_worst_bound->DB_comb);
+    MEWCP_print_list_nodes_solution_cplex(list_branching->list_nodes_best_solution, num_partitions);
 #endif
 
-                }
-
-#endif // if combinatorial bound is active
-
-                /* I check the depth */
-                if ((open_node_worst_bound->depth_level +1) > list_branching->max_exploration_level )
-                {
-                    list_branching->max_exploration_level =  (open_node_worst_bound->depth_level +1);
-                }
-
-                /* I decide what type of bound use */
-                if ( MEWCP_is_node_little_enough(son_left->list_blocked_nodes,num_partitions,cardinality_partitions,MEWCP_MAX_EXPLICIT_SOLUTIONS) == true)
-                {
-                    MEWCP_bound_explicit(son_left,matrix_weigths,num_partitions,cardinality_partitions);
+    /* Now let's fill the solution! */
+    solution_bb->node_best_primal = list_branching->serial_node_best_primal;
+    solution_bb->depth_best_primal = list_branching->depth_node_best_primal;
+    solution_bb->max_exploration_depth = list_branching->max_exploration_level;
+    solution_bb->number_explored_nodes = list_branching->number_explored_nodes;
+    solution_bb->z_opt = list_branching->best_primal;
+    solution_bb->wall_time = get_wall_time() - bb_context.time_start_wall;
+    solution_bb->number_lazy_pruned_nodes = list_branching->number_lazy_pruned_nodes;
+    solution_bb->number_sdp_iterations = list_branching->number_sdp_iterations;
+    solution_bb->number_fixed_nodes = list_branching->number_fixed_nodes;
+    solution_bb->number_sdp_tightened = list_branching->number_sdp_tightened;
+    MEWCP_clone_list_nodes_solution(list_branching->list_nodes_best_solution, solution_bb->list_nodes_best_solution, num_partitions);
 
 
-                    // I update the best value if needed
-                    new_best_PB_found = MEWCP_is_new_best_PB_and_update(son_left,list_branching,num_partitions);
+    /* Freeing structures */
 
+    MEWCP_free_bb_workers(bb_workers,bb_parameters->num_threads);
+    MEWCP_free_bound_workspaces(bb_context.bound_workspaces,bb_parameters->num_threads);
+    if (bb_context.pseudo_costs != NULL)
+    {
+        MEWCP_free_pseudo_costs(bb_context.pseudo_costs);
+    }
+    if (bb_context.bound_policy != NULL)
+    {
 #if defined MEWCP_DSDP_VERBOSE1
-
-                    if( new_best_PB_found  == true)
-                    {
-                        printf("\t*****(Explicit enumeration)  Node: %d\tNew best PB: %.2lf\n",son_left->serial_node,son_left->PB );
-                    }
+        MEWCP_print_bound_policy(bb_context.bound_policy);
 #endif
-                    left_to_be_closed = true;
-                }
-                else
-                {
-#if defined COMBINATORIAL_BOUND_ACTIVE
-                    // Combinatorial Bound
-                    if (active_combinatorial_bound == true)
-                    {
-                        MEWCP_bound_combinatorial(son_left,matrix_weigths,num_partitions,cardinality_partitions,list_branching->best_primal);
-                        new_best_PB_found = MEWCP_is_new_best_PB_and_update(son_left,list_branching,num_partitions);
-
+        MEWCP_free_bound_policy(bb_context.bound_policy);
+    }
 #if defined MEWCP_DSDP_VERBOSE1
+    if (bb_context.cut_pool != NULL)
+    {
+        MEWCP_print_cut_pool(bb_context.cut_pool);
+    }
+#endif
+    MEWCP_free_list_branching(list_branching);
+#if defined SORTED_NEIGHBOURS_ACTIVE
+    MEWCP_free_sorted_neighbours(matrix_weigths);
+#endif
+#if defined CONFLICTS_ACTIVE
+    MEWCP_free_conflicts(matrix_weigths);
+#endif
+
+    return solution_bb;
+}
+
+void * MEWCP_bb_worker(void * arg)
+{
+    bb_worker_t * bb_worker = (bb_worker_t *) arg;
+    open_node_t * open_node;
+    open_node_t * son_left;
+    open_node_t * son_right;
 
-                        if( new_best_PB_found  == true)
-                        {
-                            printf("\t*****(Comb Bound)  Node: %d\tNew best PB: %.2lf\n",son_left->serial_node,son_left->PB );
-                        }
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_bb_worker: %u *\n",bb_worker->id_worker);
 #endif
 
+    if (bb_worker->bb_context->bb_parameters->scheduler == MEWCP_SCHEDULER_STEALING)
+    {
+        while ( (open_node = MEWCP_bb_get_open_node_stealing(bb_worker)) != NULL)
+        {
+            MEWCP_bb_process_open_node(bb_worker,open_node,&son_left,&son_right);
+            MEWCP_bb_put_open_nodes_stealing(bb_worker,son_left,son_right);
+        }
+    }
+    else
+    {
+        while ( (open_node = MEWCP_bb_get_open_node(bb_worker)) != NULL)
+        {
+            MEWCP_bb_process_open_node(bb_worker,open_node,&son_left,&son_right);
+            MEWCP_bb_put_open_nodes(bb_worker,son_left,son_right);
+        }
+    }
 
+    return NULL;
+}
 
-                        // end Combinatorial Bound
+open_node_t * MEWCP_bb_get_open_node(bb_worker_t * bb_worker)
+{
+    bb_context_t * bb_context = bb_worker->bb_context;
+    list_branching_t * list_branching = bb_context->list_branching;
+    branching_open_node_t * branching_open_selected;
+    open_node_t * open_node = NULL;
 
+    /* hybrid selection: I go on with my dive without looking at the list */
+    if (bb_worker->dive_node != NULL)
+    {
+        open_node = bb_worker->dive_node;
+        bb_worker->dive_node = NULL;
 
-                        // check if left son has to be closed
-                        if ( (list_branching->best_primal - son_left->DB ) > MEWCP_EPSILON)
-                        {
-                            left_to_be_closed = true;
-                        }
-                    }
-#endif /* end combinatorial */
+        if ( ((MEWCP_bb_elapsed_time(bb_context) - bb_context->time_limit) <= MEWCP_EPSILON) &&
+             (__atomic_load_n(&list_branching->stop, __ATOMIC_ACQUIRE) == false) )
+        {
+            return open_node;
+        }
 
-                    /* Semidefinite Bound */
-                    if (left_to_be_closed == false)
-                    {
-                        MEWCP_bound(son_left,constraints_matrix,matrix_weigths, bi,num_constraints,dim_matrix,num_nodes,num_partitions,  list_branching->best_primal );
-                        /* I check if PB is improved */
-                        new_best_PB_found = MEWCP_is_new_best_PB_and_update(son_left,list_branching,num_partitions);
+        /* Time limit: the node goes back to the list so it is counted in the bound left */
+        pthread_mutex_lock(&list_branching->mutex_list);
+        MEWCP_push_open_node(open_node,list_branching);
+        list_branching->number_working_nodes -= 1;
+        if (list_branching->stop == false)
+        {
+            MEWCP_bb_stop(list_branching,true);
+        }
+        pthread_mutex_unlock(&list_branching->mutex_list);
 
-#if defined MEWCP_DSDP_VERBOSE1
+        return NULL;
+    }
 
-                        if( new_best_PB_found  == true)
-                        {
-                            printf("\t*****(SDP Bound)  Node: %d\tNew best PB: %.2lf\n",son_left->serial_node,son_left->PB );
-                        }
-#endif
+    pthread_mutex_lock(&list_branching->mutex_list);
 
-                    }
-                    /* end semidefinite bound */
+    while ( (open_node == NULL) && (list_branching->stop == false) )
+    {
+        if ((MEWCP_bb_elapsed_time(bb_context) - bb_context->time_limit) > MEWCP_EPSILON)
+        {
+            //Time limit exceeded
+            MEWCP_bb_stop(list_branching,true);
+        }
+        else if (MEWCP_is_list_branching_empty(list_branching) == false)
+        {
+            branching_open_selected = MEWCP_select_open_node(list_branching,bb_context->bb_parameters->node_selection);
+            open_node = MEWCP_pop_specific_open_node(branching_open_selected,list_branching);
+            list_branching->number_working_nodes += 1;
+        }
+        else if (list_branching->number_working_nodes == 0)
+        {
+            /* No open nodes and nobody can generate new ones: the tree is explored */
+            MEWCP_bb_stop(list_branching,false);
+        }
+        else
+        {
+            /* Another worker is branching, its sons could be for me */
+            pthread_cond_wait(&list_branching->cond_list,&list_branching->mutex_list);
+        }
+    }
 
-                    /* check if left son has to be closed */
-                    if ( (list_branching->best_primal - son_left->DB ) > MEWCP_EPSILON)
-                    {
-                        left_to_be_closed = true;
-                    }
+    pthread_mutex_unlock(&list_branching->mutex_list);
 
-                }
+    return open_node;
+}
 
-                /****** BOUND RIGHT NODE ********/
+open_node_t * MEWCP_bb_get_open_node_stealing(bb_worker_t * bb_worker)
+{
+    bb_context_t * bb_context = bb_worker->bb_context;
+    list_branching_t * list_branching = bb_context->list_branching;
+    list_branching_t * local_list = bb_worker->local_list;
+    open_node_t * open_node = NULL;
 
-                if ( MEWCP_is_node_little_enough(son_right->list_blocked_nodes,num_partitions,num_nodes/num_partitions,MEWCP_MAX_EXPLICIT_SOLUTIONS) == true)
-                {
-                    MEWCP_bound_explicit(son_right,matrix_weigths,num_partitions,num_nodes/num_partitions);
+    if (__atomic_load_n(&list_branching->stop, __ATOMIC_ACQUIRE) == true)
+    {
+        return NULL;
+    }
 
-                    // I update the best value if needed
-                    new_best_PB_found = MEWCP_is_new_best_PB_and_update(son_right,list_branching,num_partitions);
+    if ((MEWCP_bb_elapsed_time(bb_context) - bb_context->time_limit) > MEWCP_EPSILON)
+    {
+        //Time limit exceeded
+        pthread_mutex_lock(&list_branching->mutex_list);
+        if (list_branching->stop == false)
+        {
+            MEWCP_bb_stop(list_branching,true);
+        }
+        pthread_mutex_unlock(&list_branching->mutex_list);
+        return NULL;
+    }
 
-#if defined MEWCP_DSDP_VERBOSE1
+    /* I go on with my dive: the last son I pushed is on the head */
+    pthread_mutex_lock(&local_list->mutex_list);
+    if (MEWCP_is_list_branching_empty(local_list) == false)
+    {
+        open_node = MEWCP_pop_specific_open_node(local_list->head,local_list);
+    }
+    pthread_mutex_unlock(&local_list->mutex_list);
 
-                    if( new_best_PB_found  == true)
-                    {
-                        printf("\t*****(Explicit enumeration)  Node: %d\tNew best PB: %.2lf\n",son_right->serial_node,son_right->PB );
-                    }
+    if (open_node != NULL)
+    {
+        __atomic_sub_fetch(&list_branching->number_open_nodes, 1, __ATOMIC_RELAXED);
+        return open_node;
+    }
 
-#endif
+    /* My list is empty, I have to steal. I declare myself idle before looking into the other lists,
+     * so a worker that pushes after my search sees me and wakes me up */
+    pthread_mutex_lock(&list_branching->mutex_list);
+    __atomic_add_fetch(&list_branching->number_idle_workers, 1, __ATOMIC_SEQ_CST);
 
+    while (list_branching->stop == false)
+    {
+        open_node = MEWCP_bb_steal_open_node(bb_worker);
+        if (open_node != NULL)
+        {
+            break;
+        }
 
-                    right_to_be_closed = true;
-                }
-                else
-                {
-#if defined COMBINATORIAL_BOUND_ACTIVE
-                    if (active_combinatorial_bound == true)
-                    {
-                        // Combinatorial Bound
-                        MEWCP_bound_combinatorial(son_right,matrix_weigths,num_partitions,num_nodes/num_partitions,list_branching->best_primal);
+        if (__atomic_load_n(&list_branching->number_pending_nodes, __ATOMIC_SEQ_CST) == 0)
+        {
+            /* No open nodes and nobody can generate new ones: the tree is explored */
+            MEWCP_bb_stop(list_branching,false);
+            break;
+        }
 
-                        new_best_PB_found = MEWCP_is_new_best_PB_and_update(son_right,list_branching,num_partitions);
+        pthread_cond_wait(&list_branching->cond_list,&list_branching->mutex_list);
+    }
 
-#if defined MEWCP_DSDP_VERBOSE1
+    __atomic_sub_fetch(&list_branching->number_idle_workers, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&list_branching->mutex_list);
 
-                        if( new_best_PB_found  == true)
-                        {
-                            printf("\t*****(Comb Bound)  Node: %d\tNew best PB: %.2lf\n",son_right->serial_node,son_right->PB );
-                        }
-#endif
-                        // end Combinatorial Bound
+    if (open_node != NULL)
+    {
+        __atomic_sub_fetch(&list_branching->number_open_nodes, 1, __ATOMIC_RELAXED);
+    }
 
-                        // check if left son has to be closed
-                        if ( (list_branching->best_primal - son_right->DB ) > MEWCP_EPSILON)
-                        {
-                            right_to_be_closed = true;
-                        }
-                    }
-#endif /* end combinatorial */
+    return open_node;
+}
 
-                    /* Semidefinite Bound */
+open_node_t * MEWCP_bb_steal_open_node(bb_worker_t * bb_worker)
+{
+    bb_context_t * bb_context = bb_worker->bb_context;
+    list_branching_t * victim_list;
+    open_node_t * open_node = NULL;
+    unsigned int i;
+    unsigned int num_threads;
 
-                    if (right_to_be_closed == false)
-                    {
-                        MEWCP_bound(son_right,constraints_matrix,matrix_weigths, bi,num_constraints,dim_matrix,num_nodes,num_partitions, list_branching->best_primal );
+    num_threads = bb_context->bb_parameters->num_threads;
 
-                        /* I check if PB is improved */
-                        new_best_PB_found = MEWCP_is_new_best_PB_and_update(son_right,list_branching,num_partitions);
+    /* I start from the next worker so the thieves don't all rob the same one */
+    for (i=1; (i<num_threads) && (open_node == NULL); ++i)
+    {
+        victim_list = bb_context->bb_workers[(bb_worker->id_worker + i) % num_threads].local_list;
 
-#if defined MEWCP_DSDP_VERBOSE1
+        pthread_mutex_lock(&victim_list->mutex_list);
+        if (MEWCP_is_list_branching_empty(victim_list) == false)
+        {
+            /* The tail is the oldest node, the closest to the root of the victim's dive */
+            open_node = MEWCP_pop_open_node(victim_list);
+        }
+        pthread_mutex_unlock(&victim_list->mutex_list);
+    }
 
-                        if( new_best_PB_found  == true)
-                        {
-                            printf("\t*****(SDP Bound)  Node: %d\tNew best PB: %.2lf\n",son_right->serial_node,son_right->PB );
-                        }
+#if defined MEWCP_DSDP_VERBOSE2
+    if (open_node != NULL)
+    {
+        printf("Worker %u stole node %d (level %u)\n",bb_worker->id_worker,open_node->serial_node,open_node->depth_level);
+    }
 #endif
 
-                    }
-                    /* end semidefinite bound */
+    return open_node;
+}
 
-                    /* check if left son has to be closed */
-                    if ( (list_branching->best_primal - son_right->DB ) > MEWCP_EPSILON)
-                    {
-                        right_to_be_closed = true;
-                    }
-                }
+void MEWCP_bb_put_open_nodes(bb_worker_t * bb_worker, open_node_t * son_left, open_node_t * son_right)
+{
+    list_branching_t * list_branching = bb_worker->bb_context->list_branching;
 
-                /* let's close or add nodes to the open nodes */
-                if ( left_to_be_closed == true)
-                {
-                    MEWCP_close_open_node(list_branching,son_left);
-                }
-                else
-                {
-                    MEWCP_push_open_node(son_left,list_branching);
-                }
+    /* hybrid selection: while a son survives I dive into the best one */
+    if (bb_worker->bb_context->bb_parameters->node_selection == MEWCP_NODE_SELECTION_HYBRID)
+    {
+        if ( (son_left != NULL) && ( (son_right == NULL) || (MEWCP_is_better_dive_son(son_left,son_right) == true) ) )
+        {
+            bb_worker->dive_node = son_left;
+            son_left = NULL;
+        }
+        else if (son_right != NULL)
+        {
+            bb_worker->dive_node = son_right;
+            son_right = NULL;
+        }
+    }
 
+    pthread_mutex_lock(&list_branching->mutex_list);
 
-                if ( right_to_be_closed == true)
-                {
-                    MEWCP_close_open_node(list_branching,son_right);
-                }
-                else
-                {
-                    MEWCP_push_open_node(son_right,list_branching);
-                }
+    if (son_left != NULL)
+    {
+        MEWCP_push_open_node(son_left,list_branching);
+    }
+    if (son_right != NULL)
+    {
+        MEWCP_push_open_node(son_right,list_branching);
+    }
+    if (bb_worker->dive_node == NULL)
+    {
+        list_branching->number_working_nodes -= 1;
+    }
 
-            }
-        }
+    /* Waiting workers can take the sons or find out that the tree is explored */
+    if ( (son_left != NULL) || (son_right != NULL) || (list_branching->number_working_nodes == 0) )
+    {
+        pthread_cond_broadcast(&list_branching->cond_list);
+    }
 
-        /* I can close the node! */
+    pthread_mutex_unlock(&list_branching->mutex_list);
+}
 
-        MEWCP_close_open_node(list_branching,open_node_worst_bound);
+void MEWCP_bb_put_open_nodes_stealing(bb_worker_t * bb_worker, open_node_t * son_left, open_node_t * son_right)
+{
+    list_branching_t * list_branching = bb_worker->bb_context->list_branching;
+    list_branching_t * local_list = bb_worker->local_list;
+    open_node_t * tmp_son;
+    int num_sons = 0;
+    int number_pending_nodes;
+
+    /* The son with the best DB goes on the head, so I dive into it */
+    if ( (son_left != NULL) && (son_right != NULL) && (son_left->DB > son_right->DB) )
+    {
+        tmp_son = son_left;
+        son_left = son_right;
+        son_right = tmp_son;
     }
 
+    pthread_mutex_lock(&local_list->mutex_list);
+    if (son_left != NULL)
+    {
+        MEWCP_push_open_node(son_left,local_list);
+        num_sons += 1;
+    }
+    if (son_right != NULL)
+    {
+        MEWCP_push_open_node(son_right,local_list);
+        num_sons += 1;
+    }
+    pthread_mutex_unlock(&local_list->mutex_list);
 
-    /* Before I leave I'd let you know the best solution */
-#if defined MEWCP_DSDP_VERBOSE2
+    __atomic_add_fetch(&list_branching->number_open_nodes, num_sons, __ATOMIC_RELAXED);
 
+    /* the sons are pending, the father is not anymore */
+    number_pending_nodes = __atomic_add_fetch(&list_branching->number_pending_nodes, num_sons -1, __ATOMIC_SEQ_CST);
 
-    printf("\nBranch & Bound Z*: %.2lf\tExplored_nodes: %d\t Best node: %d\t\n",list_branching->best_primal,list_branching->number_explored_nodes, list_branching->serial_node_best_primal);
-#endif
-#if defined MEWCP_DSDP_VERBOSE2
+    /* Idle workers can steal the sons or find out that the tree is explored */
+    if ( ((num_sons > 0) && (__atomic_load_n(&list_branching->number_idle_workers, __ATOMIC_SEQ_CST) > 0)) ||
+         (number_pending_nodes == 0) )
+    {
+        pthread_mutex_lock(&list_branching->mutex_list);
+        pthread_cond_broadcast(&list_branching->cond_list);
+        pthread_mutex_unlock(&list_branching->mutex_list);
+    }
+}
 
-    MEWCP_print_list_nodes_solution_cplex(list_branching->list_nodes_best_solution, num_partitions);
+void MEWCP_bb_stop(list_branching_t * list_branching, const bool time_limit_reached)
+{
+    if (time_limit_reached == true)
+    {
+#if defined MEWCP_DSDP_VERBOSE1
+        printf("\n**************\tTime limit reached!\t****************\n\n");
 #endif
+        list_branching->time_limit_reached = true;
+    }
 
-    /* Now let's fill the solution! */
-    solution_bb->node_best_primal = list_branching->serial_node_best_primal;
-    solution_bb->depth_best_primal = list_branching->depth_node_best_primal;
-    solution_bb->max_exploration_depth = list_branching->max_exploration_level;
-    solution_bb->number_explored_nodes = list_branching->number_explored_nodes;
-    solution_bb->z_opt = list_branching->best_primal;
-    MEWCP_clone_list_nodes_solution(list_branching->list_nodes_best_solution, solution_bb->list_nodes_best_solution, num_partitions);
-
+    __atomic_store_n(&list_branching->stop, true, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&list_branching->cond_list);
+}
 
-    /* Freeing structures */
+double MEWCP_bb_compute_global_bound(bb_context_t * bb_context)
+{
+    list_branching_t * list_branching = bb_context->list_branching;
+    list_branching_t * current_list;
+    branching_open_node_t * element;
+    double global_bound;
+    unsigned int i;
 
-    MEWCP_free_list_branching(list_branching);
+    /* No open nodes: the best primal is optimal */
+    global_bound = MEWCP_get_best_primal(list_branching);
 
-    return solution_bb;
-}
+    for (i=0; i<=bb_context->bb_parameters->num_threads; ++i)
+    {
+        /* the shared list first, then the lists of the workers */
+        current_list = (i == 0) ? list_branching : bb_context->bb_workers[i-1].local_list;
+        if (current_list == NULL)
+        {
+            continue;
+        }
 
-void MEWCP_close_open_node(list_branching_t * list_branching, open_node_t * open_node)
-{
-#if defined MEWCP_DSDP_VERBOSE1
-    printf("-- Close node: %d\n",open_node->serial_node);
-#endif
+        pthread_mutex_lock(&current_list->mutex_list);
+        for (element = current_list->tail; element != NULL; element = element->prev_branching_node)
+        {
+            if (element->open_node->DB > global_bound)
+            {
+                global_bound = element->open_node->DB;
+            }
+        }
+        pthread_mutex_unlock(&current_list->mutex_list);
+    }
 
-    list_branching->number_explored_nodes += 1;
-    MEWCP_free_open_node(open_node);
+    return global_bound;
 }
 
-void MEWCP_bound(open_node_t * open_node, constraint_t * constraints_matrix,matrix_weights_t * matrix_weigths, double * bi,
-                 const unsigned int num_constraints,
-                 const unsigned int dim_matrix,
-                 const unsigned int num_nodes,
-                 const unsigned int num_partitions,
-                 const double best_PB)
+void MEWCP_bb_process_open_node(bb_worker_t * bb_worker, open_node_t * open_node, open_node_t ** out_son_left, open_node_t ** out_son_right)
 {
+    bb_context_t * bb_context = bb_worker->bb_context;
+    list_branching_t * list_branching = bb_context->list_branching;
 
-#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
-    printf("* MEWCP_bound *\n");
-#endif
+    bool active_combinatorial_bound = false;
 
+    /* Branching variables */
+    open_node_t * son_left;
+    open_node_t * son_right;
+    bool possible_branch;
+    bool son_closed;
 
-    unsigned int i;
-    unsigned cardinality_partition;
+    float gap; /* is the current % gap */
+    double best_primal;
 
-    /* SDP structures */
-    SDPCone sdpcone;
-    DSDP dsdp;
-    DSDPTerminationReason reason;
-    int info;
-    unsigned int num_blocks;
-    double sol_traceX;	/* Is the trace of X */
-    double pobj;   /* Is the value of sd relax */
+    *out_son_left = NULL;
+    *out_son_right = NULL;
 
+    best_primal = MEWCP_get_best_primal(list_branching);
 
-    /* varibles for rounding */
-    double z_rouded;
+    /* Lazy bounding: the node still has the DB of the father, maybe the incumbent has already passed it */
+    if (open_node->is_bounded == false)
+    {
+        if ( (open_node->DB - best_primal) > MEWCP_EPSILON )
+        {
+            son_closed = MEWCP_bound_son(bb_worker,open_node,open_node->active_combinatorial_bound);
+            MEWCP_update_pseudo_costs(bb_context->pseudo_costs,open_node);
+            if (son_closed == true)
+            {
+                MEWCP_close_open_node(list_branching,open_node);
+                return;
+            }
+            best_primal = MEWCP_get_best_primal(list_branching);
+        }
+        else
+        {
+#if defined MEWCP_DSDP_VERBOSE1
+            printf("-- Lazy pruned node: %d\tfather DB: %.2lf\n",open_node->serial_node,open_node->DB);
+#endif
+            __atomic_add_fetch(&list_branching->number_lazy_pruned_nodes, 1, __ATOMIC_RELAXED);
+        }
+    }
 
-    num_blocks = NUM_BLOCKS;
-    cardinality_partition = num_nodes/num_partitions;
+    if ( (open_node->DB - best_primal) > MEWCP_EPSILON )
+    {
 
-    info = DSDPCreate(num_constraints,&dsdp);
-    info = DSDPCreateSDPCone(dsdp,num_blocks,&sdpcone);
-    info = SDPConeSetBlockSize(sdpcone, 0, num_nodes);  /* dimension of block is n */
+        gap = (open_node->DB - best_primal)/best_primal * 100;
+#if defined MEWCP_DSDP_VERBOSE1
 
+        /* The counters are changed by the other workers, I read them atomically */
+        printf("\n++ Current DB(%d): %.2lf \t level: %u \tBest P(%d): %.2lf \t open_nodes: %d\t explored: %u \t gap: %.3f %%\n",open_node->serial_node,open_node->DB, open_node->depth_level,
+               __atomic_load_n(&list_branching->serial_node_best_primal, __ATOMIC_RELAXED),best_primal,
+               __atomic_load_n(&list_branching->number_open_nodes, __ATOMIC_RELAXED),
+               __atomic_load_n(&list_branching->number_explored_nodes, __ATOMIC_RELAXED),gap);
+#endif
 
+        possible_branch = MEWCP_branch(open_node,bb_context->dim_matrix,bb_context->num_nodes,bb_context->num_partitions,bb_context->num_constraints,open_node->depth_level, &list_branching->current_serial_number,
+                                       bb_context->bb_parameters->branching_rule,bb_context->pseudo_costs,bb_context->matrix_weigths,bb_worker->workspace, &son_left,&son_right);
 
-    /* I feel the DSP structures */
-    for (i=0;i<num_constraints;++i)
-    {
-        info = DSDPSetDualObjective(dsdp,i+1,bi[i]);
-    }
 
-    for (i=0; i < num_constraints +1; ++i) /* Matrix are number of constraints +1 because of matrix W */
-    {
-        if (i != num_constraints ) /* It's not the last constraint matrix */
-        {
-            SDPConeSetASparseVecMat(sdpcone, 0, i, num_nodes, MEWCP_ALPHA, 0, constraints_matrix[i].index, constraints_matrix[i].weight, constraints_matrix[i].num_nz);
 
-        }
-        else /* It's the last matrix containing branching contraints */
+        if (possible_branch == true)
         {
-            SDPConeSetASparseVecMat(sdpcone, 0, i, num_nodes, MEWCP_ALPHA, 0, open_node->vect_mat_branching_contraint->index, open_node->vect_mat_branching_contraint->weight, open_node->vect_mat_branching_contraint->num_nz);
 
-        }
+#if defined COMBINATORIAL_BOUND_ACTIVE
+            /* I want to know if combinatorial bound was convinient on the father */
+            if( ((open_node->DB_SDP - open_node->DB_comb) > MEWCP_EPSILON) && open_node->DB_comb != 0)
+            {
+                active_combinatorial_bound = true;
+#if defined  MEWCP_DSDP_VERBOSE2
 
-#if defined MEWCP_BOUNDING_DEBUG
-        printf("%d Another contrain matrix:\n",i);
-        SDPConeViewDataMatrix(sdpcone, 0, i);
+                printf("combinatorial ACTIVE\t DB_SDP= %.2lf\t DB_comb= %.2lf\n", open_node->DB_SDP,open_node->DB_comb);
 #endif
 
-    }
+            }
+            else
+            {
+                active_combinatorial_bound = false;
+#if defined  MEWCP_DSDP_VERBOSE2
 
-    /* set DSDP parameters */
+                printf("combinatorial NOT active\t  DB_SDP= %.2lf\t DB_comb= %.2lf\n",open_node->DB_SDP,open_node->DB_comb);
+#endif
+
+            }
 
-    info=DSDPSetGapTolerance(dsdp,MEWCP_GAP_TOLERANCE);
-    info=DSDPSetPotentialParameter(dsdp,MEWCP_POTENTIAL_PARAMETER);
-    info=DSDPReuseMatrix(dsdp,MEWCP_REUSE_MATRIX);
-    info=DSDPSetPNormTolerance(dsdp,MEWCP_SET_PNORM_TOLERANCE);
-    //info = DSDPSetR0(dsdp,);
+#endif // if combinatorial bound is active
 
+            /* I check the depth */
+            MEWCP_update_max_exploration_level(list_branching,open_node->depth_level +1);
 
-    /* I stop the computation when DD is greater to -best_PB */
-    info = DSDPSetDualBound( dsdp, -best_PB);
+            if (bb_context->bb_parameters->lazy_bounding == true)
+            {
+                /* The sons will be bounded when popped, meanwhile they have the DB of the father */
+                son_left->DB = open_node->DB;
+                son_left->estimate = open_node->estimate;
+                son_left->active_combinatorial_bound = active_combinatorial_bound;
+                son_right->DB = open_node->DB;
+                son_right->estimate = open_node->estimate;
+                son_right->active_combinatorial_bound = active_combinatorial_bound;
+
+                *out_son_left = son_left;
+                *out_son_right = son_right;
+            }
+            else
+            {
+                /* let's close or give back the sons */
+                son_closed = MEWCP_bound_son(bb_worker,son_left,active_combinatorial_bound);
+                MEWCP_update_pseudo_costs(bb_context->pseudo_costs,son_left);
+                if (son_closed == true)
+                {
+                    MEWCP_close_open_node(list_branching,son_left);
+                }
+                else
+                {
+                    *out_son_left = son_left;
+                }
 
+                son_closed = MEWCP_bound_son(bb_worker,son_right,active_combinatorial_bound);
+                MEWCP_update_pseudo_costs(bb_context->pseudo_costs,son_right);
+                if (son_closed == true)
+                {
+                    MEWCP_close_open_node(list_branching,son_right);
+                }
+                else
+                {
+                    *out_son_right = son_right;
+                }
+            }
 
+        }
+    }
 
-#if defined MEWCP_BOUNDING_VERBOSE2
+    /* I can close the node! */
 
-    DSDPSetStandardMonitor(dsdp, 1); /* verbose each iteration */
-    DSDPLogInfoAllow(1,0);
-#endif
+    MEWCP_close_open_node(list_branching,open_node);
+}
 
+bool MEWCP_bound_son(bb_worker_t * bb_worker, open_node_t * son, const bool active_combinatorial_bound)
+{
+    bb_context_t * bb_context = bb_worker->bb_context;
+    list_branching_t * list_branching = bb_context->list_branching;
+    bool new_best_PB_found;
+    bool to_be_closed = false;
+    bool use_combinatorial_bound;
+    bool use_lagrangian_bound;
+    bool use_explicit_bound;
+    double time_start;
+    double explicit_work;
+#if defined EXPLICIT_DFS_ACTIVE
+    double max_explicit_work;
+#endif
+#if defined NODE_FIXING_ACTIVE
+    unsigned int num_fixed_nodes;
+    double best_primal;
+#endif
 
+    son->is_bounded = true;
 
+#if defined NODE_FIXING_ACTIVE
+    best_primal = MEWCP_get_best_primal(list_branching);
 
-    /* Now I set the initial values of the variables y in (D) */
-    for (i=0; i< num_constraints; ++i)
+    /* With a better best primal than the one of the last fixing more nodes can be blocked */
+    if ( (son->depth_level <= MEWCP_NODE_FIXING_MAX_DEPTH) && ((best_primal - son->fixing_best_primal) > MEWCP_EPSILON) )
     {
-        DSDPSetY0(dsdp, i+1, open_node->vect_y[i]);
+        son->fixing_best_primal = best_primal;
+
+        if (MEWCP_compute_combinatorial_fixing(son,bb_worker->workspace,bb_context->matrix_weigths,bb_context->num_partitions,bb_context->cardinality_partitions,best_primal,&num_fixed_nodes) == false)
+        {
+#if defined MEWCP_DSDP_VERBOSE1
+            printf("-- Fixing (%d): a partition is empty\n",son->serial_node);
+#endif
+            /* No solution in the son */
+            son->DB = (double) MEWCP_MIN_DOUBLE;
+            __atomic_add_fetch(&list_branching->number_fixed_nodes, num_fixed_nodes, __ATOMIC_RELAXED);
+            return true;
+        }
 
+        if (num_fixed_nodes > 0)
+        {
+#if defined MEWCP_DSDP_VERBOSE1
+            printf("-- Fixing (%d): %u nodes blocked\n",son->serial_node,num_fixed_nodes);
+#endif
+            __atomic_add_fetch(&list_branching->number_fixed_nodes, num_fixed_nodes, __ATOMIC_RELAXED);
+            MEWCP_generate_constraints_branch(son->list_blocked_nodes, son->vect_mat_branching_contraint,bb_context->dim_matrix,bb_context->num_nodes,bb_context->cardinality_partitions);
+            if (son->pair_bounds != NULL)
+            {
+                MEWCP_compute_pair_bounds(son,bb_context->matrix_weigths,bb_context->num_partitions,bb_context->cardinality_partitions);
+            }
+        }
     }
+#endif
 
-    DSDPSetup(dsdp);
-    DSDPSolve(dsdp);
+#if defined TRIVIAL_BOUND_ACTIVE
+    /* First tier: the pair bounds, O(m^2) */
+    time_start = get_thread_cpu_time();
+    if (MEWCP_bound_trivial(son,bb_context->num_partitions) == true)
+    {
+        if ( (MEWCP_get_best_primal(list_branching) - son->DB ) > MEWCP_EPSILON)
+        {
+            to_be_closed = true;
+        }
+        MEWCP_bound_policy_add(bb_context->bound_policy,son->depth_level,MEWCP_BOUND_TRIVIAL,get_thread_cpu_time() - time_start,to_be_closed);
+        if (to_be_closed == true)
+        {
+            return true;
+        }
+    }
+#endif
 
-    DSDPComputeX(dsdp);
+    /* I decide what type of bound use */
+#if defined EXPLICIT_DFS_ACTIVE
+    /* The enumeration is chosen if it is predicted cheaper than the SDP way */
+    max_explicit_work = MEWCP_bound_policy_explicit_work(bb_context->bound_policy,son->depth_level);
+    explicit_work = MEWCP_estimate_explicit_work(son->list_blocked_nodes,bb_worker->workspace,bb_context->num_partitions,bb_context->cardinality_partitions,max_explicit_work);
+    use_explicit_bound = (explicit_work <= max_explicit_work);
+#else
+    explicit_work = 0;
+    use_explicit_bound = MEWCP_is_node_explicit(son->list_blocked_nodes,bb_worker->workspace,bb_context->num_partitions,bb_context->cardinality_partitions);
+#endif
+    if (use_explicit_bound == true)
+    {
+        time_start = get_thread_cpu_time();
+        MEWCP_bound_explicit(son,bb_worker->workspace,bb_context->matrix_weigths,bb_context->num_partitions,bb_context->cardinality_partitions,MEWCP_get_best_primal(list_branching));
 
-    DSDPStopReason(dsdp, &reason);
-    DSDPGetPObjective(dsdp, &pobj);
-    DSDPGetTraceX(dsdp, &sol_traceX);
+        // I update the best value if needed
+        new_best_PB_found = MEWCP_is_new_best_PB_and_update(son,list_branching,bb_context->num_partitions);
 
-#if defined MEWCP_BOUNDING_DEBUG
+#if defined MEWCP_DSDP_VERBOSE1
 
-    if ((reason != 1) && (reason != 5))
-    {
-        printf("DSDP Error!: %d\n",reason);
-        getchar();
-    }
+        if( new_best_PB_found  == true)
+        {
+            printf("\t*****(Explicit enumeration)  Node: %d\tNew best PB: %.2lf\n",son->serial_node,son->PB );
+        }
 #endif
-    /* I take the negative pobj */
-    pobj = -pobj;
+        MEWCP_bound_policy_add_explicit(bb_context->bound_policy,son->depth_level,explicit_work,get_thread_cpu_time() - time_start);
+        return true;
+    }
 
-#if defined MEWCP_BOUNDING_DEBUG
+#if defined COMBINATORIAL_BOUND_ACTIVE
+    use_combinatorial_bound = active_combinatorial_bound;
+#if defined BOUND_POLICY_ACTIVE
+    /* The measured cost and prune rate decide, not the father */
+    use_combinatorial_bound = MEWCP_bound_policy_use_bound(bb_context->bound_policy,son->depth_level,MEWCP_BOUND_COMBINATORIAL);
+#endif
 
-    double * sol_vect_X;
-    int sol_dim_vect_X;
+    // Combinatorial Bound
+    if (use_combinatorial_bound == true)
+    {
+        time_start = get_thread_cpu_time();
+        MEWCP_bound_combinatorial(son,bb_worker->workspace,bb_context->matrix_weigths,bb_context->num_partitions,bb_context->cardinality_partitions,MEWCP_get_best_primal(list_branching));
+        new_best_PB_found = MEWCP_is_new_best_PB_and_update(son,list_branching,bb_context->num_partitions);
 
+#if defined MEWCP_DSDP_VERBOSE1
 
-    SDPConeGetXArray(sdpcone, 0, &sol_vect_X, &sol_dim_vect_X);
+        if( new_best_PB_found  == true)
+        {
+            printf("\t*****(Comb Bound)  Node: %d\tNew best PB: %.2lf\n",son->serial_node,son->PB );
+        }
+#endif
 
-    printf("\n");
-    SDPConeViewX(sdpcone, 0, num_nodes, sol_vect_X, sol_dim_vect_X);
-    printf("\n");
+        // check if the son has to be closed
+        if ( (MEWCP_get_best_primal(list_branching) - son->DB ) > MEWCP_EPSILON)
+        {
+            to_be_closed = true;
+        }
+        MEWCP_bound_policy_add(bb_context->bound_policy,son->depth_level,MEWCP_BOUND_COMBINATORIAL,get_thread_cpu_time() - time_start,to_be_closed);
+    }
+#endif /* end combinatorial */
 
+#if defined LAGRANGIAN_BOUND_ACTIVE
+    use_lagrangian_bound = (to_be_closed == false);
+#if defined BOUND_POLICY_ACTIVE
+    if (use_lagrangian_bound == true)
+    {
+        use_lagrangian_bound = MEWCP_bound_policy_use_bound(bb_context->bound_policy,son->depth_level,MEWCP_BOUND_LAGRANGIAN);
+    }
 #endif
 
+    // Lagrangian Bound
+    if (use_lagrangian_bound == true)
+    {
+        time_start = get_thread_cpu_time();
+        MEWCP_bound_lagrangian(son,bb_worker->workspace,bb_context->matrix_weigths,bb_context->num_partitions,bb_context->cardinality_partitions,MEWCP_get_best_primal(list_branching));
+        new_best_PB_found = MEWCP_is_new_best_PB_and_update(son,list_branching,bb_context->num_partitions);
 
-    /* Now I get the diagonal of solution X */
-
-    open_node->diagX = MEWCP_allocate_diag_X(num_nodes);
-    MEWCP_dump_diag_X(&sdpcone,open_node->diagX,num_nodes);
+#if defined MEWCP_DSDP_VERBOSE1
 
-    /* Now I get the value of Y variables */
-    open_node->vect_y = MEWCP_allocate_vect_y(num_constraints);
-    MEWCP_dump_vect_y(&dsdp, open_node->vect_y, num_constraints);
+        if( new_best_PB_found  == true)
+        {
+            printf("\t*****(Lagrangian Bound)  Node: %d\tNew best PB: %.2lf\n",son->serial_node,son->PB );
+        }
+#endif
 
+        if ( (MEWCP_get_best_primal(list_branching) - son->DB ) > MEWCP_EPSILON)
+        {
+            to_be_closed = true;
+        }
+        MEWCP_bound_policy_add(bb_context->bound_policy,son->depth_level,MEWCP_BOUND_LAGRANGIAN,get_thread_cpu_time() - time_start,to_be_closed);
+    }
+#endif
 
-#if defined MEWCP_BOUNDING_DEBUG
+    /* Semidefinite Bound */
+    if (to_be_closed == false)
+    {
+        time_start = get_thread_cpu_time();
+        MEWCP_bound(son,bb_worker->workspace,bb_context->constraints_matrix,bb_context->matrix_weigths, bb_context->bi,bb_context->num_constraints,bb_context->dim_matrix,bb_context->num_nodes,bb_context->num_partitions,  MEWCP_get_best_primal(list_branching),bb_context->cut_pool );
+        MEWCP_update_sdp_statistics(list_branching,son);
+        /* I check if PB is improved */
+        new_best_PB_found = MEWCP_is_new_best_PB_and_update(son,list_branching,bb_context->num_partitions);
 
-    MEWCP_print_diag_X(open_node->diagX,num_nodes);
-    MEWCP_print_vectorY(open_node->vect_y,num_constraints);
+#if defined MEWCP_DSDP_VERBOSE1
 
+        if( new_best_PB_found  == true)
+        {
+            printf("\t*****(SDP Bound)  Node: %d\tNew best PB: %.2lf\n",son->serial_node,son->PB );
+        }
 #endif
 
+        /* check if the son has to be closed */
+        if ( (MEWCP_get_best_primal(list_branching) - son->DB ) > MEWCP_EPSILON)
+        {
+            to_be_closed = true;
+        }
+        MEWCP_bound_policy_add(bb_context->bound_policy,son->depth_level,MEWCP_BOUND_SDP,get_thread_cpu_time() - time_start,to_be_closed);
+    }
 
-    /* I compute the rounding of diagonan_X */
+    if (to_be_closed == false)
+    {
+        MEWCP_compute_estimate(son,bb_context->num_nodes,bb_context->num_partitions);
+    }
 
-    int * list_nodes_rounded = MEWCP_allocate_list_nodes_solution(num_partitions);
+    return to_be_closed;
+}
 
+double MEWCP_bb_elapsed_time(bb_context_t * bb_context)
+{
+    /* With more workers the cpu time runs faster than the real one */
+    if (bb_context->bb_parameters->num_threads > 1)
+    {
+        return bb_context->time_start_cpu + (get_wall_time() - bb_context->time_start_wall);
+    }
 
-    MEWCP_compute_sdp_rounding(open_node->diagX,list_nodes_rounded,num_nodes,cardinality_partition);
-#if defined MEWCP_BOUNDING_VERBOSE2
+    return get_cpu_time();
+}
 
-    MEWCP_print_list_nodes_solution(list_nodes_rounded,num_partitions);
+void MEWCP_close_open_node(list_branching_t * list_branching, open_node_t * open_node)
+{
+#if defined MEWCP_DSDP_VERBOSE1
+    printf("-- Close node: %d\n",open_node->serial_node);
 #endif
 
-    z_rouded = MEWCP_evaluate_list_nodes_solution(list_nodes_rounded,matrix_weigths,num_partitions);
-
+    __atomic_add_fetch(&list_branching->number_explored_nodes, 1, __ATOMIC_RELAXED);
+    MEWCP_free_open_node(open_node);
+}
 
+/*
+ * Running the combinatorial bound before the SDP one costs t_comb + (1 - p_comb) * t_sdp
+ * instead of t_sdp, where p_comb is the fraction of the nodes it closes.
+ * The statistics are the ones of the depth level of the node if there are enough calls.
+ */
+bool MEWCP_bound_policy_use_bound(bound_policy_t * bound_policy, const unsigned int depth_level, const unsigned int bound_type)
+{
+    unsigned int i;
+    unsigned int level;
+    bound_statistics_t bound;
+    bound_statistics_t sdp;
+    bool use_bound;
 
-#if defined MEWCP_BOUNDING_DEBUG
+    level = depth_level;
+    if (level >= MEWCP_POLICY_DEPTH_LEVELS)
+    {
+        level = MEWCP_POLICY_DEPTH_LEVELS -1;
+    }
 
-    printf("Trace X: %.2lf\n",sol_traceX);
-#endif
+    pthread_mutex_lock(&bound_policy->mutex);
 
-#if defined MEWCP_BOUNDING_VERBOSE1
+    bound = bound_policy->statistics[level][bound_type];
+    sdp = bound_policy->statistics[level][MEWCP_BOUND_SDP];
 
-    printf("(BB)  Bound SDP: (%d) DB: %.2lf \t Rounded: %.2lf \t level: %u \t Status: %d\n",open_node->serial_node, pobj,z_rouded, open_node->depth_level,reason);
-#endif
+    if ( (bound.num_calls < MEWCP_POLICY_MIN_SAMPLES) || (sdp.num_calls < MEWCP_POLICY_MIN_SAMPLES) )
+    {
+        /* Too few nodes at this level, I take all the levels */
+        memset(&bound, 0, sizeof(bound_statistics_t));
+        memset(&sdp, 0, sizeof(bound_statistics_t));
+        for (i=0; i<MEWCP_POLICY_DEPTH_LEVELS; ++i)
+        {
+            bound.num_calls += bound_policy->statistics[i][bound_type].num_calls;
+            bound.num_closed += bound_policy->statistics[i][bound_type].num_closed;
+            bound.time += bound_policy->statistics[i][bound_type].time;
+            sdp.num_calls += bound_policy->statistics[i][MEWCP_BOUND_SDP].num_calls;
+            sdp.time += bound_policy->statistics[i][MEWCP_BOUND_SDP].time;
+        }
+    }
 
+    if ( (bound.num_calls < MEWCP_POLICY_MIN_SAMPLES) || (sdp.num_calls < MEWCP_POLICY_MIN_SAMPLES) )
+    {
+        /* I'm still learning */
+        use_bound = true;
+    }
+    else
+    {
+        use_bound = (bound.time / bound.num_calls) <
+                    ((double) bound.num_closed / bound.num_calls) * (sdp.time / sdp.num_calls);
 
+        if (use_bound == false)
+        {
+            /* Once in a while I run it anyway: with a better best primal it can start closing nodes */
+            bound_policy->num_rejected[bound_type] += 1;
+            if ( (bound_policy->num_rejected[bound_type] % MEWCP_POLICY_EXPLORATION_PERIOD) == 0)
+            {
+                use_bound = true;
+            }
+        }
+    }
 
+    pthread_mutex_unlock(&bound_policy->mutex);
 
-    /* Update open_node */
+    return use_bound;
+}
 
-    open_node->DB_SDP = pobj;
-    open_node->PB_SDP = z_rouded;
+void MEWCP_bound_policy_add(bound_policy_t * bound_policy, const unsigned int depth_level, const unsigned int bound_type,
+                            const double time, const bool closed)
+{
+    unsigned int level;
 
-    if ((open_node->DB - pobj) > MEWCP_EPSILON )
+    if (bound_policy == NULL)
     {
-        open_node->DB = pobj;
+        return;
     }
 
-    if ( (z_rouded - open_node->PB) > MEWCP_EPSILON )
+    level = depth_level;
+    if (level >= MEWCP_POLICY_DEPTH_LEVELS)
     {
-        open_node->PB = z_rouded;
-        open_node->list_nodes_solution = MEWCP_allocate_list_nodes_solution(num_partitions);
-        MEWCP_clone_list_nodes_solution(list_nodes_rounded,open_node->list_nodes_solution,num_partitions);
+        level = MEWCP_POLICY_DEPTH_LEVELS -1;
     }
 
+    pthread_mutex_lock(&bound_policy->mutex);
 
-    MEWCP_free_list_nodes_solution(list_nodes_rounded);
-    DSDPDestroy ( dsdp);
-
+    bound_policy->statistics[level][bound_type].num_calls += 1;
+    bound_policy->statistics[level][bound_type].time += time;
+    if (closed == true)
+    {
+        bound_policy->statistics[level][bound_type].num_closed += 1;
+    }
 
+    pthread_mutex_unlock(&bound_policy->mutex);
 }
 
-bool MEWCP_branch( open_node_t * open_node,
-                   const unsigned int dim_matrix,
-                   const unsigned int num_nodes,
-                   const unsigned int num_partitions,
-                   const unsigned int num_constraints,
-                   const unsigned int father_depth_level,
-                   unsigned int * serial_number_node,
-                   open_node_t ** out_left_son,
-                   open_node_t ** out_right_son)
-
+/*
+ * The SDP way costs at least the bound of the node and, if it does not close it (probability 1 - p_sdp),
+ * the bounds of its two sons: t_sdp * (1 + 2 (1 - p_sdp)). The enumeration costs its estimated work times
+ * the measured time of a unit.
+ */
+double MEWCP_bound_policy_explicit_work(bound_policy_t * bound_policy, const unsigned int depth_level)
 {
-#if defined MEWCP_DSDP_DEBUG
-    printf("* MEWCP_branching *\n");
-#endif
-
-    unsigned cardinality_partition;
-
-
-    /* varibles for branching */
-    int out_num_part;
-    int out_id_node;
-    bool possible_branch;
-    open_node_t * son_left;  /* In case of branching is possible */
-    open_node_t * son_right;
-
+    unsigned int i;
+    unsigned int level;
+    bound_statistics_t enumeration;
+    bound_statistics_t sdp;
+    double max_work;
+    double sdp_cost;
 
-    cardinality_partition = num_nodes/num_partitions;
+    if (bound_policy == NULL)
+    {
+        return MEWCP_MAX_EXPLICIT_WORK;
+    }
 
+    level = depth_level;
+    if (level >= MEWCP_POLICY_DEPTH_LEVELS)
+    {
+        level = MEWCP_POLICY_DEPTH_LEVELS -1;
+    }
 
+    pthread_mutex_lock(&bound_policy->mutex);
 
-    /* WELL Now let's generate branching sons */
-    possible_branch = MEWCP_generate_perfect_equi_branch(open_node->diagX,num_nodes,num_partitions,&out_num_part,&out_id_node);
-    //possible_branch = MEWCP_generate_max_fractional_branch(open_node->diagX,num_nodes,num_partitions,&out_num_part,&out_id_node);
+    /* The cost of a unit does not depend on the depth */
+    memset(&enumeration, 0, sizeof(bound_statistics_t));
+    for (i=0; i<MEWCP_POLICY_DEPTH_LEVELS; ++i)
+    {
+        enumeration.num_calls += bound_policy->statistics[i][MEWCP_BOUND_EXPLICIT].num_calls;
+        enumeration.time += bound_policy->statistics[i][MEWCP_BOUND_EXPLICIT].time;
+    }
 
+    sdp = bound_policy->statistics[level][MEWCP_BOUND_SDP];
+    if (sdp.num_calls < MEWCP_POLICY_MIN_SAMPLES)
+    {
+        memset(&sdp, 0, sizeof(bound_statistics_t));
+        for (i=0; i<MEWCP_POLICY_DEPTH_LEVELS; ++i)
+        {
+            sdp.num_calls += bound_policy->statistics[i][MEWCP_BOUND_SDP].num_calls;
+            sdp.num_closed += bound_policy->statistics[i][MEWCP_BOUND_SDP].num_closed;
+            sdp.time += bound_policy->statistics[i][MEWCP_BOUND_SDP].time;
+        }
+    }
 
-#if defined MEWCP_DSDP_DEBUG
+    if ( (enumeration.num_calls < MEWCP_POLICY_MIN_SAMPLES) || (sdp.num_calls < MEWCP_POLICY_MIN_SAMPLES) )
+    {
+        /* I'm still learning */
+        max_work = MEWCP_MAX_EXPLICIT_WORK;
+    }
+    else if (enumeration.time <= 0)
+    {
+        max_work = (double) MEWCP_MAX_EXPLICIT_WORK * MEWCP_POLICY_EXPLICIT_RANGE;
+    }
+    else
+    {
+        sdp_cost = (sdp.time / sdp.num_calls) * (1 + 2*(1 - (double) sdp.num_closed / sdp.num_calls));
+        max_work = sdp_cost * bound_policy->explicit_work / enumeration.time;
+    }
 
-    printf("Possible branch: %d \t partition: %d \t id_node: %d \n",possible_branch, out_num_part, out_id_node);
-#endif
+    pthread_mutex_unlock(&bound_policy->mutex);
 
-    if (possible_branch == true) /* Branching is possible */
+    /* A few unlucky measures must not stop the enumeration nor let it take the whole tree */
+    if (max_work < (double) MEWCP_MAX_EXPLICIT_WORK / MEWCP_POLICY_EXPLICIT_RANGE)
     {
+        max_work = (double) MEWCP_MAX_EXPLICIT_WORK / MEWCP_POLICY_EXPLICIT_RANGE;
+    }
+    if (max_work > (double) MEWCP_MAX_EXPLICIT_WORK * MEWCP_POLICY_EXPLICIT_RANGE)
+    {
+        max_work = (double) MEWCP_MAX_EXPLICIT_WORK * MEWCP_POLICY_EXPLICIT_RANGE;
+    }
 
-        son_left = MEWCP_allocate_open_node();
-        son_right = MEWCP_allocate_open_node();
-
-        son_left->id_node = 2*open_node->id_node +1;
-        son_right->id_node = 2*open_node->id_node +2;
+    return max_work;
+}
 
-        *serial_number_node +=1;
-        son_left->serial_node = *serial_number_node;
-        *serial_number_node +=1;
-        son_right->serial_node = *serial_number_node;
+void MEWCP_bound_policy_add_explicit(bound_policy_t * bound_policy, const unsigned int depth_level,
+                                     const double work, const double time)
+{
+    if (bound_policy == NULL)
+    {
+        return;
+    }
 
+    MEWCP_bound_policy_add(bound_policy,depth_level,MEWCP_BOUND_EXPLICIT,time,true);
 
-        son_left->list_blocked_nodes = MEWCP_allocate_list_blocked_nodes(num_nodes);
-        son_right->list_blocked_nodes = MEWCP_allocate_list_blocked_nodes( num_nodes);
+    pthread_mutex_lock(&bound_policy->mutex);
+    bound_policy->explicit_work += work;
+    pthread_mutex_unlock(&bound_policy->mutex);
+}
 
-        /* I generate blocked nodes */
-        MEWCP_generate_list_blocked_nodes_branching_sons(open_node->list_blocked_nodes, son_left->list_blocked_nodes, son_right->list_blocked_nodes,out_num_part, out_id_node,num_nodes,cardinality_partition);
+void MEWCP_update_sdp_statistics(list_branching_t * list_branching, open_node_t * open_node)
+{
+    __atomic_add_fetch(&list_branching->number_sdp_iterations, open_node->sdp_iterations, __ATOMIC_RELAXED);
+    if (open_node->sdp_tightened == true)
+    {
+        __atomic_add_fetch(&list_branching->number_sdp_tightened, 1, __ATOMIC_RELAXED);
+    }
+}
 
-#if defined MEWCP_DSDP_DEBUG
+void MEWCP_bound(open_node_t * open_node, bound_workspace_t * workspace, constraint_t * constraints_matrix,matrix_weights_t * matrix_weigths, double * bi,
+                 const unsigned int num_constraints,
+                 const unsigned int dim_matrix,
+                 const unsigned int num_nodes,
+                 const unsigned int num_partitions,
+                 const double best_PB,
+                 cut_pool_t * cut_pool)
+{
 
-        MEWCP_print_list_blocked_nodes(son_left->list_blocked_nodes);
-        MEWCP_print_list_blocked_nodes(son_right->list_blocked_nodes);
+#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
+    printf("* MEWCP_bound *\n");
 #endif
 
-        /* generate branching constraints based on the blocked nodes */
-        son_left->vect_mat_branching_contraint = MEWCP_allocate_vect_mat_branching_constraints(dim_matrix);
-        son_right->vect_mat_branching_contraint = MEWCP_allocate_vect_mat_branching_constraints( dim_matrix);
-
-        MEWCP_generate_constraints_branch(son_left->list_blocked_nodes, son_left->vect_mat_branching_contraint,dim_matrix,num_nodes,cardinality_partition);
-        MEWCP_generate_constraints_branch(son_right->list_blocked_nodes, son_right->vect_mat_branching_contraint, dim_matrix,num_nodes,cardinality_partition);
 
+    unsigned cardinality_partition;
 
-        /* I clone the vect_y */
-        son_left->vect_y = MEWCP_allocate_vect_y(num_constraints);
-        son_right->vect_y = MEWCP_allocate_vect_y(num_constraints);
+    /* SDP structures */
+    SDPCone sdpcone;
+    DSDP dsdp;
+    DSDPTerminationReason reason;
+    double sol_traceX;	/* Is the trace of X */
+    double pobj;   /* Is the value of sd relax */
+    double dobj;
+    int iterations;
+    double r;		/* infeasibility variable of (D) at the coarse solution */
+    sdp_reduction_t * reduction;	/* NULL if the node is solved on all the nodes */
+    unsigned int num_sdp_nodes;
+    double fixed_value;		/* of the contracted nodes, not in the SDP */
+    double sdp_best_PB;		/* best_PB for the SDP without the fixed value */
 
-        MEWCP_clone_vect_y(open_node->vect_y, son_left->vect_y,num_constraints);
-        MEWCP_clone_vect_y(open_node->vect_y, son_right->vect_y,num_constraints);
 
-        /* I set the level */
-        son_left->depth_level = father_depth_level +1;
-        son_right->depth_level = father_depth_level +1;
+    /* varibles for rounding */
+    double z_rouded;
 
-        *out_left_son = son_left;
-        *out_right_son = son_right;
+    cardinality_partition = num_nodes/num_partitions;
 
-        return true;
-    }
-    else
+    reduction = NULL;
+#if defined REDUCED_SDP_ACTIVE
+    num_sdp_nodes = num_nodes - open_node->list_blocked_nodes->num_blocked_nodes -
+                    MEWCP_mark_fixed_nodes(open_node->list_blocked_nodes,num_nodes,cardinality_partition,NULL);
+    if ( num_sdp_nodes <= MEWCP_REDUCED_SDP_RATIO * num_nodes )
     {
-        return false;
+        reduction = workspace->sdp_reduction;
+        MEWCP_reduce_sdp_problem(reduction,open_node,constraints_matrix,bi,num_constraints,num_nodes,cardinality_partition);
     }
-
-}
-
-branching_open_node_t * MEWCP_find_worst_bound_element(list_branching_t * list_branching )
-{
-#if defined MEWCP_DSDP_DEBUG
-    printf("* MEWCP_find_worst_bound_element *\n");
 #endif
+    fixed_value = MEWCP_get_sdp_fixed_value(reduction);
+    sdp_best_PB = best_PB - fixed_value;
 
-    branching_open_node_t * worst_element = NULL;
-    branching_open_node_t * element;
-    double worst_bound;
+    dsdp = MEWCP_create_sdp_node_problem(open_node,constraints_matrix,bi,num_constraints,num_nodes,reduction,
+                                         sdp_best_PB,&sdpcone);
 
-    worst_bound = MEWCP_MIN_DOUBLE;
+#if defined ADAPTIVE_GAP_ACTIVE
+    /* A coarse solution is enough to decide most of the nodes */
+    DSDPSetGapTolerance(dsdp,MEWCP_GAP_TOLERANCE_LOOSE);
+#endif
 
-#if defined ASSERT
+    DSDPSolve(dsdp);
+    DSDPGetIts(dsdp, &iterations);
+    open_node->sdp_iterations = iterations;
+    open_node->sdp_tightened = false;
 
-    assert(MEWCP_is_list_branching_empty(list_branching) == false);
-#endif
+#if defined ADAPTIVE_GAP_ACTIVE
+    DSDPGetDObjective(dsdp, &dobj);
+    DSDPGetPObjective(dsdp, &pobj);
 
-    /* I search worse element from the tail */
-    for(element = list_branching->tail; element != NULL; element = element->prev_branching_node)
+    /* The SDP value is between -pobj and -dobj: if best_PB is in between (or near)
+     * I can't say if the node is prunable, I go on from the coarse y with the tight tolerance.
+     * The root is always tight, its DB is reported
+     */
+    if ( ((-dobj - sdp_best_PB) > MEWCP_EPSILON) &&
+            ( ((-pobj - sdp_best_PB) <= MEWCP_ADAPTIVE_GAP_MARGIN * fabs(best_PB)) || (open_node->depth_level == 0) ) )
     {
-        if( (element->open_node->DB -  worst_bound) >= MEWCP_EPSILON )
+        if (open_node->vect_y == NULL)
         {
-            worst_bound = element->open_node->DB;
-            worst_element = element;
+            open_node->vect_y = MEWCP_allocate_vect_y(num_constraints);
         }
+        MEWCP_dump_node_vect_y(&dsdp, reduction, open_node->vect_y, num_constraints);
+        DSDPGetR(dsdp, &r);
+
+        /* Same problem, already set up: the tight solve starts from the coarse y and r */
+        DSDPSetGapTolerance(dsdp,MEWCP_GAP_TOLERANCE);
+        MEWCP_set_node_Y0(dsdp, reduction, open_node->vect_y, num_constraints);
+        DSDPSetR0(dsdp, r);
+
+        DSDPSolve(dsdp);
+        DSDPGetIts(dsdp, &iterations);
+        open_node->sdp_iterations += iterations;
+        open_node->sdp_tightened = true;
     }
-    return worst_element;
-}
+#endif
 
-bool MEWCP_is_list_branching_empty(list_branching_t * list_branching)
-{
-    bool is_empty;
+    DSDPComputeX(dsdp);
 
-    /* I check that pointer to head and tail are NULL */
+    DSDPStopReason(dsdp, &reason);
+    DSDPGetPObjective(dsdp, &pobj);
+    DSDPGetTraceX(dsdp, &sol_traceX);
 
-    if ( (list_branching->head == NULL) &&  ( list_branching->tail == NULL  ) )
-    {
-        is_empty = true;
-    }
-    else
+#if defined MEWCP_BOUNDING_DEBUG
+
+    if ((reason != 1) && (reason != 5))
     {
-        is_empty = false;
+        printf("DSDP Error!: %d\n",reason);
+        getchar();
     }
-    return is_empty;
-}
+#endif
+#if defined ADAPTIVE_GAP_ACTIVE
+    /* A coarse pobj can be under the SDP value, the dual objective is always a valid bound */
+    DSDPGetDObjective(dsdp, &dobj);
+    pobj = dobj;
+#endif
 
-void MEWCP_push_open_node(open_node_t * open_node, list_branching_t * list_branching)
-{
-    /* I insert the element to the head */
-    branching_open_node_t * element;
-    branching_open_node_t * element_tmp;
+    /* I take the negative pobj, with the fixed nodes */
+    pobj = -pobj + fixed_value;
 
-    /* I create a list element */
-    element = MEWCP_allocate_branching_open_node();
+#if defined MEWCP_BOUNDING_DEBUG
 
-    element->open_node = open_node;
+    double * sol_vect_X;
+    int sol_dim_vect_X;
 
-    /* I have to append the element to the head */
-    /* The list is empty */
-    if( MEWCP_is_list_branching_empty(list_branching) == true)
-    {
-        list_branching->head = element;
-        list_branching->tail = element;
 
-        element->prev_branching_node = NULL;
-        element->next_branching_node = NULL;
-    }
-    else /* the list isn't empty */
-    {
+    SDPConeGetXArray(sdpcone, 0, &sol_vect_X, &sol_dim_vect_X);
 
-        element_tmp = list_branching->head;
+    printf("\n");
+    SDPConeViewX(sdpcone, 0, MEWCP_get_sdp_block_size(reduction,num_nodes), sol_vect_X, sol_dim_vect_X);
+    printf("\n");
 
-        list_branching->head = element;
+#endif
 
-        element->prev_branching_node = NULL;
-        element->next_branching_node = element_tmp;
 
-        element_tmp->prev_branching_node = element;
+    /* Now I get the diagonal of solution X */
+
+    if (open_node->diagX == NULL)
+    {
+        open_node->diagX = MEWCP_allocate_diag_X(num_nodes);
     }
+    MEWCP_dump_node_diag_X(&sdpcone,reduction,open_node->diagX,num_nodes);
 
-    list_branching->number_open_nodes += 1;
+    /* Now I get the value of Y variables, the vector cloned from the father is overwritten */
+    if (open_node->vect_y == NULL)
+    {
+        open_node->vect_y = MEWCP_allocate_vect_y(num_constraints);
+    }
+    MEWCP_dump_node_vect_y(&dsdp, reduction, open_node->vect_y, num_constraints);
 
+#if defined CUTTING_PLANES_ACTIVE
+    /* Near the best primal the cuts may close the node, the root is always cut for its DB */
+    if ( (cut_pool != NULL) && ((pobj - best_PB) > MEWCP_EPSILON) &&
+            ( ((pobj - best_PB) <= MEWCP_CUT_MARGIN * fabs(best_PB)) || (open_node->depth_level == 0) ) )
+    {
+        pobj = MEWCP_bound_cutting_planes(open_node,workspace,cut_pool,constraints_matrix,bi,num_constraints,num_nodes,pobj,best_PB,&sdpcone,reduction);
+    }
+#endif
 
-}
 
-open_node_t * MEWCP_pop_open_node( list_branching_t * list_branching)
-{
-    open_node_t * open_node;
-    branching_open_node_t * element;
+#if defined MEWCP_BOUNDING_DEBUG
 
-#if defined ASSERT
+    MEWCP_print_diag_X(open_node->diagX,num_nodes);
+    MEWCP_print_vectorY(open_node->vect_y,num_constraints);
 
-    assert( MEWCP_is_list_branching_empty(list_branching) == false);
 #endif
 
-    /* I extract the element from the tail */
 
-    /* If the element is the first */
-    if ( list_branching->tail->prev_branching_node == NULL)
-    {
-#if defined ASSERT
-        /* The head and the tail point to the same first element */
-        assert(  list_branching->head == list_branching->tail );
-#endif
+    /* I compute the rounding of diagonan_X */
 
-        element = list_branching->tail;
-        list_branching->head = NULL;
-        list_branching->tail = NULL;
-    }
-    else /* element isn't the first */
-    {
-#if defined ASSERT
-        /* I have at least one previous element  */
-        assert (  list_branching->tail->prev_branching_node != NULL );
+    int * list_nodes_rounded = MEWCP_allocate_list_nodes_solution(num_partitions);
+
+
+    MEWCP_compute_sdp_rounding(open_node->diagX,list_nodes_rounded,num_nodes,cardinality_partition);
+#if defined MEWCP_BOUNDING_VERBOSE2
+
+    MEWCP_print_list_nodes_solution(list_nodes_rounded,num_partitions);
 #endif
 
-        element = list_branching->tail;
+    z_rouded = MEWCP_evaluate_sdp_roundings(open_node->diagX,list_nodes_rounded,open_node->list_blocked_nodes,workspace,matrix_weigths,num_partitions,cardinality_partition);
+#if defined LOCAL_SEARCH_ACTIVE
+    z_rouded = MEWCP_improve_list_nodes_solution(list_nodes_rounded,z_rouded,open_node->list_blocked_nodes,matrix_weigths,num_partitions,cardinality_partition,workspace->alternative_values);
+#endif
 
-        list_branching->tail = element->prev_branching_node;
-        list_branching->tail->next_branching_node = NULL;
 
-    }
 
-    open_node = element->open_node;
-    list_branching->number_open_nodes -= 1;
-    free(element); /* I only free the element with the pointers but not the open_node structure */
-    return open_node;
-}
+#if defined MEWCP_BOUNDING_DEBUG
 
-open_node_t * MEWCP_pop_specific_open_node(branching_open_node_t * branching_open_node , list_branching_t * list_branching)
-{
-#if defined MEWCP_DSDP_DEBUG
-    printf("* MEWCP_pop_specific_open_node: %d *\n",branching_open_node->open_node->id_node);
+    printf("Trace X: %.2lf\n",sol_traceX);
 #endif
 
-    open_node_t * open_node;
-
-#if defined ASSERT
+#if defined MEWCP_BOUNDING_VERBOSE1
 
-    assert( MEWCP_is_list_branching_empty(list_branching) == false);
+    printf("(BB)  Bound SDP: (%d) DB: %.2lf \t Rounded: %.2lf \t level: %u \t Status: %d\n",open_node->serial_node, pobj,z_rouded, open_node->depth_level,reason);
 #endif
 
-    /* I extract the given  branching_open_node element from the list */
 
-    /* If the element is the only element in the list */
-
-    if ( (branching_open_node->prev_branching_node == NULL) && ( branching_open_node->next_branching_node == NULL) )
-    {
-#if defined ASSERT
-        /* The head and the tail point to the same first element */
-        assert(  list_branching->head == list_branching->tail );
-        assert(  list_branching->head ==  branching_open_node);
 
-#endif
-
-        list_branching->head = NULL;
-        list_branching->tail = NULL;
-    }
-    else if (branching_open_node->prev_branching_node == NULL) /* element is the first but not the only*/
-    {
-#if defined ASSERT
-        /* I have at least one follow element  */
-        assert (  list_branching->head == branching_open_node);
-        assert ( branching_open_node->next_branching_node != NULL );
-#endif
 
-        list_branching->head = branching_open_node->next_branching_node;
-        list_branching->head->prev_branching_node = NULL;
+    /* Update open_node */
 
+    open_node->DB_SDP = pobj;
+    open_node->PB_SDP = z_rouded;
 
-    }
-    else if (branching_open_node->next_branching_node == NULL) /* element is the last but not the only*/
+    if ((open_node->DB - pobj) > MEWCP_EPSILON )
     {
-#if defined ASSERT
-        /* I have at least one follow element  */
-        assert (  list_branching->tail == branching_open_node);
-        assert ( branching_open_node->prev_branching_node != NULL );
-#endif
-
-        list_branching->tail = branching_open_node->prev_branching_node;
-        list_branching->tail->next_branching_node = NULL;
+        open_node->DB = pobj;
     }
-    else /* Element is not the tail nor the head of the list */
+
+    if ( (z_rouded - open_node->PB) > MEWCP_EPSILON )
     {
-#if defined ASSERT
+        open_node->PB = z_rouded;
+        if (open_node->list_nodes_solution == NULL)
+        {
+            open_node->list_nodes_solution = MEWCP_allocate_list_nodes_solution(num_partitions);
+        }
+        MEWCP_clone_list_nodes_solution(list_nodes_rounded,open_node->list_nodes_solution,num_partitions);
+    }
 
-        assert ( branching_open_node->prev_branching_node != NULL );
-        assert ( branching_open_node->next_branching_node != NULL );
-#endif
 
-        branching_open_node->prev_branching_node->next_branching_node = branching_open_node->next_branching_node;
-        branching_open_node->next_branching_node->prev_branching_node = branching_open_node->prev_branching_node;
-    }
+    MEWCP_free_list_nodes_solution(list_nodes_rounded);
+    DSDPDestroy ( dsdp);
 
-    open_node = branching_open_node->open_node;
-    list_branching->number_open_nodes -= 1;
-    free(branching_open_node); /* I only free the element with the pointers but not the open_node structure */
-    return open_node;
-}
 
+}
 
-void MEWCP_generate_list_blocked_nodes_branching_sons(list_blocked_nodes_t * father_blocked_nodes,
-        list_blocked_nodes_t * left_son_blocked_nodes,
-        list_blocked_nodes_t * right_son_blocked_nodes,
-        const int branch_num_part,
-        const int branch_id_node,
-        const unsigned int num_nodes,
-        const unsigned int cardinality_partition )
+DSDP MEWCP_create_sdp_node_problem(open_node_t * open_node, constraint_t * constraints_matrix, double * bi,
+                                   const unsigned int num_constraints,
+                                   const unsigned int num_nodes,
+                                   sdp_reduction_t * reduction,
+                                   const double sdp_best_PB,
+                                   SDPCone * out_sdpcone)
 {
-    int  boundaries[4];
-    int i;
+    DSDP dsdp;
+    SDPCone sdpcone;
 
+    DSDPCreate(MEWCP_get_sdp_num_variables(reduction,num_constraints),&dsdp);
+    DSDPCreateSDPCone(dsdp,NUM_BLOCKS,&sdpcone);
+    SDPConeSetBlockSize(sdpcone, 0, MEWCP_get_sdp_block_size(reduction,num_nodes));  /* dimension of block is n, or the free nodes */
 
-    /* As first thing I clone the father blocked list */
-    MEWCP_clone_list_blocked_modes(father_blocked_nodes, left_son_blocked_nodes,num_nodes);
-    MEWCP_clone_list_blocked_modes(father_blocked_nodes, right_son_blocked_nodes,num_nodes);
+    /* I feel the DSP structures and the initial values of the variables y in (D) */
+    MEWCP_load_sdp_node_problem(dsdp,sdpcone,open_node,constraints_matrix,bi,num_constraints,num_nodes,reduction);
 
-    /* I consider left son the one with nodes blocked on the right of branch_id_node in the same partition */
-    /* I consider right son the one with nodes blocked on the left of branch_id_node (also blocked) in the same partition */
+    /* set DSDP parameters */
+    DSDPSetGapTolerance(dsdp,MEWCP_GAP_TOLERANCE);
+    DSDPSetPotentialParameter(dsdp,MEWCP_POTENTIAL_PARAMETER);
+    DSDPReuseMatrix(dsdp,MEWCP_REUSE_MATRIX);
+    DSDPSetPNormTolerance(dsdp,MEWCP_SET_PNORM_TOLERANCE);
+    //DSDPSetR0(dsdp,);
 
-    /* [ left-son +| branch_id_node || 0 | 0 | 0 ]
-     * [ 0 | 0 | 0 | branch_id_node || right-son ]
-     */
+    /* I stop the computation when DD is greater to -best_PB */
+    DSDPSetDualBound(dsdp, -sdp_best_PB);
 
-    /* I have in boundaries[0]=a and boundaries[1]=b   [a  X  X  X  b] */
-    trova_boundaries_diagonale(cardinality_partition,branch_id_node,boundaries);
+#if defined MEWCP_BOUNDING_VERBOSE2
 
-    /* I fill in the right son first */
-    for(i=boundaries[0]; i<= branch_id_node; ++i )
+    DSDPSetStandardMonitor(dsdp, 1); /* verbose each iteration */
+    DSDPLogInfoAllow(1,0);
+#endif
+
+    DSDPSetup(dsdp);
+
+    *out_sdpcone = sdpcone;
+    return dsdp;
+}
+
+unsigned int MEWCP_get_sdp_num_variables(sdp_reduction_t * reduction, const unsigned int num_constraints)
+{
+    if (reduction == NULL)
     {
-        MEWCP_add_blocked_node(i,right_son_blocked_nodes);
+        return num_constraints;
     }
-    /* Now, I fill in the left son */
-    for(i=branch_id_node+1; i<= boundaries[1]; ++i )
+    return reduction->num_kept - 1;
+}
+
+unsigned int MEWCP_get_sdp_block_size(sdp_reduction_t * reduction, const unsigned int num_nodes)
+{
+    if (reduction == NULL)
     {
-        MEWCP_add_blocked_node(i,left_son_blocked_nodes);
+        return num_nodes;
     }
-
+    return reduction->num_free;
 }
 
-bool MEWCP_generate_equi_branch_node(double * diag_X, const unsigned int n, const unsigned int m,  int * out_num_part,  int * out_id_node)
+double MEWCP_get_sdp_fixed_value(sdp_reduction_t * reduction)
 {
-#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
-    printf("* MEWCP_generate_equi_branch_node *\n");
-#endif
-
-    unsigned int i,j,c;
-    double sum_partition[m];
-    int  id_node_part[m];
-    int num_fract_var[m];
-    double min_diff;
-    double cur_min_diff;
-
-    double  sum_cur;
-    int max_num_fract_var =0;
-
-    c = n/m;
-
-    for(i=0;i<m;++i)
+    if (reduction == NULL)
     {
+        return 0.0;
+    }
+    return reduction->fixed_value;
+}
 
-        cur_min_diff = 1;
-        sum_cur = 0;
-
-        num_fract_var[i] = 0;
-
+void MEWCP_load_sdp_node_problem(DSDP dsdp, SDPCone sdpcone, open_node_t * open_node,
+                                 constraint_t * constraints_matrix, double * bi,
+                                 const unsigned int num_constraints,
+                                 const unsigned int num_nodes,
+                                 sdp_reduction_t * reduction)
+{
+    unsigned int i;
 
-        for(j=i*c;j<(i*c +c); ++j )
+    if (reduction == NULL)
+    {
+        for (i=0;i<num_constraints;++i)
         {
-            /* I find the number of fractional variables */
-            sum_cur += diag_X[j];
-
+            DSDPSetDualObjective(dsdp,i+1,bi[i]);
+        }
 
-            if ( (fabs(sum_cur - 0.5) < cur_min_diff) && (diag_X[j] > MEWCP_EPSILON )  && ( (1.0 - diag_X[j])  > MEWCP_EPSILON)  )
+        for (i=0; i < num_constraints +1; ++i) /* Matrix are number of constraints +1 because of matrix W */
+        {
+            if (i != num_constraints ) /* It's not the last constraint matrix */
             {
-                cur_min_diff = fabs(sum_cur - 0.5);
-
-                id_node_part[i] = j;
-                sum_partition[i] = sum_cur;
-
-                num_fract_var[i] += 1;
+                SDPConeSetASparseVecMat(sdpcone, 0, i, num_nodes, MEWCP_ALPHA, 0, constraints_matrix[i].index, constraints_matrix[i].weight, constraints_matrix[i].num_nz);
 
-                if (num_fract_var[i] > max_num_fract_var)
-                {
-                    /* I set the maximum fractional number of variables */
-                    max_num_fract_var = num_fract_var[i];
-                }
+            }
+            else /* It's the last matrix containing branching contraints */
+            {
+                SDPConeSetASparseVecMat(sdpcone, 0, i, num_nodes, MEWCP_ALPHA, 0, open_node->vect_mat_branching_contraint->index, open_node->vect_mat_branching_contraint->weight, open_node->vect_mat_branching_contraint->num_nz);
 
             }
-#if defined MEWCP_BRANCHING_DEBUG
 
-            printf("Part: %d \t diag[%d]: %.5lf \t Sum: %.5lf num_fract: %d\n",i,j,diag_X[j],sum_cur,num_fract_var[i]);
+#if defined MEWCP_BOUNDING_DEBUG
+            printf("%d Another contrain matrix:\n",i);
+            SDPConeViewDataMatrix(sdpcone, 0, i);
 #endif
 
         }
-#if defined MEWCP_BRANCHING_DEBUG
-        printf("Ho preso: %d \t somma: %.2lf\n",id_node_part[i],sum_partition[i]);
-#endif
-
     }
-    min_diff = 1;
-    for (i=0;i<m;++i)
+    else
     {
-        if ( num_fract_var[i] == max_num_fract_var )
+        /* The kept constraints are numbered again, W is still the first */
+        for (i=1; i<reduction->num_kept; ++i)
         {
+            DSDPSetDualObjective(dsdp,i,reduction->bi[i-1]);
+        }
+        for (i=0; i<reduction->num_kept; ++i)
+        {
+            SDPConeSetASparseVecMat(sdpcone, 0, i, reduction->num_free, MEWCP_ALPHA, 0, reduction->constraints[i].index, reduction->constraints[i].weight, reduction->constraints[i].num_nz);
+        }
+    }
 
+    /* Now I set the initial values of the variables y in (D) */
+    MEWCP_set_node_Y0(dsdp, reduction, open_node->vect_y, num_constraints);
+}
 
+void MEWCP_set_node_Y0(DSDP dsdp, sdp_reduction_t * reduction, double * vect_y, const unsigned int num_constraints)
+{
+    unsigned int i;
 
-            /* I take the partition node nearest to sum 0.5 */
-
-            if (  ( fabs(sum_partition[i] - 0.5) < min_diff)   )
-            {
-
+    if (reduction == NULL)
+    {
+        for (i=0; i< num_constraints; ++i)
+        {
+            DSDPSetY0(dsdp, i+1, vect_y[i]);
+        }
+        return;
+    }
 
-                min_diff = fabs(sum_partition[i] - 0.5);
-#if defined MEWCP_BRANCHING_DEBUG
+    for (i=1; i<reduction->num_kept; ++i)
+    {
+        DSDPSetY0(dsdp, i, vect_y[reduction->kept[i]-1]);
+    }
+}
 
-                printf("sum_part[%d]: %.2lf \t mindiff: %.2lf\n",i,sum_partition[i], min_diff);
-#endif
+unsigned int MEWCP_mark_fixed_nodes(list_blocked_nodes_t * list_blocked_nodes, const unsigned int num_nodes,
+                                    const unsigned int cardinality_partitions,
+                                    bool * out_is_fixed)
+{
+    unsigned int i,k;
+    unsigned int num_free;
+    unsigned int num_fixed;
+    int free_node;
 
-                *out_id_node = id_node_part[i];
-                *out_num_part = i;
+    if (out_is_fixed != NULL)
+    {
+        memset(out_is_fixed, 0, num_nodes * sizeof(bool));
+    }
+#if defined CONTRACTED_SDP_ACTIVE
+    num_fixed = 0;
+    for (k=0; k<num_nodes; k+=cardinality_partitions)
+    {
+        num_free = 0;
+        free_node = -1;
+        for (i=k; i<k+cardinality_partitions; ++i)
+        {
+            if (list_blocked_nodes->bool_list[i] == false)
+            {
+                num_free += 1;
+                free_node = i;
+            }
+        }
+        if (num_free == 0)
+        {
+            /* The node has no solution, I leave it as it is */
+            num_fixed = 0;
+            break;
+        }
+        if (num_free == 1)
+        {
+            num_fixed += 1;
+            if (out_is_fixed != NULL)
+            {
+                out_is_fixed[free_node] = true;
             }
-
         }
     }
 
-
-
-    if ( max_num_fract_var < 1 )
+    /* The SDP needs a block */
+    if ((num_fixed > 0) && (num_fixed < num_nodes / cardinality_partitions))
     {
-
-        return false;
+        return num_fixed;
     }
-    else
+    if (out_is_fixed != NULL)
     {
-#if defined MEWCP_BRANCHING_DEBUG
-        printf("taken\t part: %d \t node: %d\n",*out_num_part, *out_id_node);
-#endif
-
-        return true;
+        memset(out_is_fixed, 0, num_nodes * sizeof(bool));
     }
-
+#endif
+    return 0;
 }
 
-bool MEWCP_generate_perfect_equi_branch(double * diag_X, const unsigned int n, const unsigned int m,  int * out_num_part,  int * out_id_node)
+int MEWCP_restrict_packed_matrix(sdp_reduction_t * reduction, const int * index, const double * weight, const int num_nz,
+                                 int * out_index, double * out_weight, double * out_constant)
 {
-#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
-    printf("* MEWCP_generate_perfect_equi_branch_node *\n");
-#endif
-
-
-    unsigned int i,j,c;
-    double sum_partition[m];
-    int  id_node_part[m];
-    int num_fract_var[m];
-    double min_diff;
-    double cur_min_diff;
-
-    double  sum_cur;
-    int max_num_fract_var =0;
-
-    c = n/m;
-
-    for(i=0;i<m;++i)
+    int p;
+    int num_restricted;
+    int num_touched;
+    int t;
+    unsigned int i,j;
+    int reduced_i, reduced_j;
+    int * position;
+    double element;
+
+    position = reduction->diagonal_position;
+    num_restricted = 0;
+    num_touched = 0;
+    *out_constant = 0.0;
+    for (p=0; p<num_nz; ++p)
     {
+        MEWCP_convert_vector_matrix_to_coords_ij(index[p], &i, &j);
+        reduced_i = reduction->reduced_node[i-1];
+        reduced_j = reduction->reduced_node[j-1];
 
-        cur_min_diff = 1;
-        sum_cur = 0;
-
-        num_fract_var[i] = 0;
+        if ((reduced_i == -1) || (reduced_j == -1))
+        {
+            continue;
+        }
 
+        /* The element weighs twice in A.X if it is off the diagonal */
+        element = (i == j) ? weight[p] : 2 * weight[p];
 
-        for(j=i*c;j<(i*c +c); ++j )
+        if ((reduced_i == MEWCP_FIXED_NODE) && (reduced_j == MEWCP_FIXED_NODE))
         {
-            /* I find the number of fractional variables */
-            sum_cur += diag_X[j];
+            /* X_fg = 1 */
+            *out_constant += element;
+            continue;
+        }
+        if ((reduced_i == MEWCP_FIXED_NODE) || (reduced_j == MEWCP_FIXED_NODE) || (i == j))
+        {
+            /* X_fj = X_jj: it is summed on the diagonal of j */
+            if (reduced_i == MEWCP_FIXED_NODE)
+            {
+                reduced_i = reduced_j;
+            }
+            if (position[reduced_i] < 0)
+            {
+                position[reduced_i] = num_restricted;
+                reduction->diagonal_touched[num_touched] = reduced_i;
+                ++num_touched;
+                out_index[num_restricted] = MEWCP_convert_coords_ij_to_vector_matrix(reduced_i+1, reduced_i+1);
+                out_weight[num_restricted] = 0.0;
+                ++num_restricted;
+            }
+            out_weight[position[reduced_i]] += element;
+            continue;
+        }
 
+        /* The free nodes keep their order, so reduced_i >= reduced_j */
+        out_index[num_restricted] = MEWCP_convert_coords_ij_to_vector_matrix(reduced_i+1, reduced_j+1);
+        out_weight[num_restricted] = weight[p];
+        ++num_restricted;
+    }
 
-            if( (diag_X[j] - 0 ) >= MEWCP_EPSILON )
-            {
-                num_fract_var[i] += 1;
+    if (num_touched == 0)
+    {
+        return num_restricted;
+    }
 
-                if (num_fract_var[i] > max_num_fract_var)
-                {
-                    /* I set the maximum fractional number of variables */
-                    max_num_fract_var = num_fract_var[i];
-                }
-            }
+    /* The diagonal elements cancelled by the contraction are dropped */
+    for (t=0; t<num_touched; ++t)
+    {
+        reduced_i = reduction->diagonal_touched[t];
+        if (fabs(out_weight[position[reduced_i]]) <= MEWCP_EPSILON)
+        {
+            out_index[position[reduced_i]] = -1;
+        }
+        position[reduced_i] = -1;
+    }
+    t = 0;
+    for (p=0; p<num_restricted; ++p)
+    {
+        if (out_index[p] >= 0)
+        {
+            out_index[t] = out_index[p];
+            out_weight[t] = out_weight[p];
+            ++t;
+        }
+    }
+    return t;
+}
 
+bool MEWCP_branch( open_node_t * open_node,
+                   const unsigned int dim_matrix,
+                   const unsigned int num_nodes,
+                   const unsigned int num_partitions,
+                   const unsigned int num_constraints,
+                   const unsigned int father_depth_level,
+                   unsigned int * serial_number_node,
+                   const unsigned int branching_rule,
+                   pseudo_costs_t * pseudo_costs,
+                   matrix_weights_t * matrix_weights,
+                   bound_workspace_t * workspace,
+                   open_node_t ** out_left_son,
+                   open_node_t ** out_right_son)
 
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_branching *\n");
+#endif
 
+    unsigned cardinality_partition;
 
 
-            if ( fabs(sum_cur - 0.5) < cur_min_diff )
-            {
-                cur_min_diff = fabs(sum_cur - 0.5);
+    /* varibles for branching */
+    int out_num_part;
+    int out_id_node;
+    bool possible_branch;
+    int i;
+    int boundaries[4];
+    double mass_left;   /* fractional mass of the nodes kept by the left son */
+    double mass_right;
+    open_node_t * son_left;  /* In case of branching is possible */
+    open_node_t * son_right;
 
-                id_node_part[i] = j;
-                sum_partition[i] = sum_cur;
 
-            }
-#if defined MEWCP_BRANCHING_DEBUG
+    cardinality_partition = num_nodes/num_partitions;
 
-            printf("Part: %d \t diag[%d]: %.4lf \t Sum: %.2lf num_fract: %d\n",i,j,diag_X[j],sum_cur,num_fract_var[i]);
-#endif
 
-        }
-#if defined MEWCP_BRANCHING_DEBUG
-        printf("Ho preso: %d \t somma: %.2lf\n",id_node_part[i],sum_partition[i]);
-#endif
 
+    /* WELL Now let's generate branching sons */
+    switch (branching_rule)
+    {
+    case MEWCP_BRANCHING_EQUI:
+        possible_branch = MEWCP_generate_equi_branch_node(open_node->diagX,num_nodes,num_partitions,&out_num_part,&out_id_node);
+        break;
+    case MEWCP_BRANCHING_MAX_FRACTIONAL:
+        possible_branch = MEWCP_generate_max_fractional_branch(open_node->diagX,num_nodes,num_partitions,&out_num_part,&out_id_node);
+        break;
+    case MEWCP_BRANCHING_PSEUDO_COST:
+        possible_branch = MEWCP_generate_pseudo_cost_branch(open_node,pseudo_costs,matrix_weights,workspace,num_nodes,num_partitions,&out_num_part,&out_id_node);
+        break;
+    default:
+        possible_branch = MEWCP_generate_perfect_equi_branch(open_node->diagX,num_nodes,num_partitions,&out_num_part,&out_id_node);
+        break;
     }
-    min_diff = 1;
-    for (i=0;i<m;++i)
+
+
+#if defined MEWCP_DSDP_DEBUG
+
+    printf("Possible branch: %d \t partition: %d \t id_node: %d \n",possible_branch, out_num_part, out_id_node);
+#endif
+
+    if (possible_branch == true) /* Branching is possible */
     {
-        if ( num_fract_var[i] == max_num_fract_var )
-        {
 
+        son_left = MEWCP_allocate_open_node();
+        son_right = MEWCP_allocate_open_node();
+
+        son_left->id_node = 2*open_node->id_node +1;
+        son_right->id_node = 2*open_node->id_node +2;
 
+        /* The serial number is shared by all the B&B workers */
+        son_left->serial_node = __atomic_add_fetch(serial_number_node, 1, __ATOMIC_RELAXED);
+        son_right->serial_node = __atomic_add_fetch(serial_number_node, 1, __ATOMIC_RELAXED);
 
-            /* I take the partition node nearest to sum 0.5 */
 
-            if (  ( fabs(sum_partition[i] - 0.5) < min_diff)   )
-            {
+        son_left->list_blocked_nodes = MEWCP_allocate_list_blocked_nodes(num_nodes);
+        son_right->list_blocked_nodes = MEWCP_allocate_list_blocked_nodes( num_nodes);
 
+        /* I generate blocked nodes */
+        MEWCP_generate_list_blocked_nodes_branching_sons(open_node->list_blocked_nodes, son_left->list_blocked_nodes, son_right->list_blocked_nodes,out_num_part, out_id_node,num_nodes,cardinality_partition);
 
-                min_diff = fabs(sum_partition[i] - 0.5);
-#if defined MEWCP_BRANCHING_DEBUG
+#if defined MEWCP_DSDP_DEBUG
 
-                printf("sum_part[%d]: %.2lf \t mindiff: %.2lf\n",i,sum_partition[i], min_diff);
+        MEWCP_print_list_blocked_nodes(son_left->list_blocked_nodes);
+        MEWCP_print_list_blocked_nodes(son_right->list_blocked_nodes);
 #endif
 
-                *out_id_node = id_node_part[i];
-                *out_num_part = i;
-            }
+        /* generate branching constraints based on the blocked nodes */
+        son_left->vect_mat_branching_contraint = MEWCP_allocate_vect_mat_branching_constraints(dim_matrix);
+        son_right->vect_mat_branching_contraint = MEWCP_allocate_vect_mat_branching_constraints( dim_matrix);
+
+        MEWCP_generate_constraints_branch(son_left->list_blocked_nodes, son_left->vect_mat_branching_contraint,dim_matrix,num_nodes,cardinality_partition);
+        MEWCP_generate_constraints_branch(son_right->list_blocked_nodes, son_right->vect_mat_branching_contraint, dim_matrix,num_nodes,cardinality_partition);
+
+
+        /* I clone the vect_y */
+        son_left->vect_y = MEWCP_allocate_vect_y(num_constraints);
+        son_right->vect_y = MEWCP_allocate_vect_y(num_constraints);
+
+        MEWCP_clone_vect_y(open_node->vect_y, son_left->vect_y,num_constraints);
+        MEWCP_clone_vect_y(open_node->vect_y, son_right->vect_y,num_constraints);
+
+        /* I set the level */
+        son_left->depth_level = father_depth_level +1;
+        son_right->depth_level = father_depth_level +1;
 
+        /* I remember the split: the DB degradation of the sons updates the pseudo-costs */
+        trova_boundaries_diagonale(cardinality_partition,out_id_node,boundaries);
+        mass_left = 0;
+        mass_right = 0;
+        for(i=boundaries[0]; i<= boundaries[1]; ++i )
+        {
+            if (i <= out_id_node)
+            {
+                mass_left += open_node->diagX[i];
+            }
+            else
+            {
+                mass_right += open_node->diagX[i];
+            }
         }
-    }
 
+        son_left->branch_split_node = out_id_node;
+        son_left->branch_is_left = true;
+        son_left->branch_mass = mass_right;
+        son_left->father_DB = open_node->DB;
 
+        son_right->branch_split_node = out_id_node;
+        son_right->branch_is_left = false;
+        son_right->branch_mass = mass_left;
+        son_right->father_DB = open_node->DB;
 
-    if ( max_num_fract_var < 2 )
-    {
+        son_left->fixing_best_primal = open_node->fixing_best_primal;
+        son_right->fixing_best_primal = open_node->fixing_best_primal;
 
-        return false;
+        /* Only the pairs of the branched partition change */
+        son_left->pair_bounds = MEWCP_clone_pair_bounds(open_node->pair_bounds,num_partitions);
+        son_right->pair_bounds = MEWCP_clone_pair_bounds(open_node->pair_bounds,num_partitions);
+        MEWCP_update_pair_bounds_partition(son_left,matrix_weights,out_num_part,num_partitions,cardinality_partition);
+        MEWCP_update_pair_bounds_partition(son_right,matrix_weights,out_num_part,num_partitions,cardinality_partition);
+
+        /* The combinatorial bound of the sons starts from the father's one, shared until they are bounded */
+        son_left->combinatorial_cache = MEWCP_share_combinatorial_cache(open_node->combinatorial_cache);
+        son_right->combinatorial_cache = MEWCP_share_combinatorial_cache(open_node->combinatorial_cache);
+
+        /* The Lagrangian bound of the sons is warm started, the multipliers are copied only by the son that is bounded */
+        son_left->lagrangian_multipliers = MEWCP_share_lagrangian_multipliers(open_node->lagrangian_multipliers);
+        son_right->lagrangian_multipliers = MEWCP_share_lagrangian_multipliers(open_node->lagrangian_multipliers);
+
+        *out_left_son = son_left;
+        *out_right_son = son_right;
+
+        return true;
     }
     else
     {
-#if defined MEWCP_BRANCHING_DEBUG
-        printf("taken\t part: %d \t node: %d\n",*out_num_part, *out_id_node);
-#endif
-
-        return true;
+        return false;
     }
+
 }
 
-/*
- * I select the partition with the most number of fractional variables
- * I take the element that divides the partition in 2 equi number of fractional
- * If I have more than one partition with the same max number of fract variables I take the one with pivot element having nearest sum to 1/2
- */
-bool MEWCP_generate_max_fractional_branch(double * diag_X, const unsigned int n, const unsigned int m,  int * out_num_part,  int * out_id_node)
+branching_open_node_t * MEWCP_find_worst_bound_element(list_branching_t * list_branching )
 {
-#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
-    printf("* MEWCP_generate_max_fractional_branch *\n");
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_find_worst_bound_element *\n");
 #endif
 
+    branching_open_node_t * worst_element = NULL;
+    branching_open_node_t * element;
+    double worst_bound;
 
-    unsigned int i,j,c;
-
-
-    int num_fract_var[m];
-    double min_diff;
-
+    worst_bound = MEWCP_MIN_DOUBLE;
 
-    double  sum_cur;
-    int max_num_fract_var =0;
+#if defined ASSERT
 
-    c = n/m;
-    int fract[m][c];  // number of fractional varibles until that node
-    double sum[m][c];  //density until that element
+    assert(MEWCP_is_list_branching_empty(list_branching) == false);
+#endif
 
-    /* I have to clean the vectors */
-    for(i=0;i<m;++i)
+    /* I search worse element from the tail */
+    for(element = list_branching->tail; element != NULL; element = element->prev_branching_node)
     {
-        for (j = 0; j < c; ++j)
+        if( (element->open_node->DB -  worst_bound) >= MEWCP_EPSILON )
         {
-            fract[i][j] = 0;
-            sum[i][j] = 0.0;
+            worst_bound = element->open_node->DB;
+            worst_element = element;
         }
     }
+    return worst_element;
+}
 
+double MEWCP_get_best_primal(list_branching_t * list_branching)
+{
+    double best_primal;
 
-    for(i=0;i<m;++i)
-    {
-
+    __atomic_load(&list_branching->best_primal, &best_primal, __ATOMIC_ACQUIRE);
+    return best_primal;
+}
 
-        sum_cur = 0;
+void MEWCP_update_max_exploration_level(list_branching_t * list_branching, const unsigned int depth_level)
+{
+    unsigned int max_level;
 
-        num_fract_var[i] = 0;
+    max_level = __atomic_load_n(&list_branching->max_exploration_level, __ATOMIC_RELAXED);
 
+    /* If another worker changes it I retry with its value */
+    while ( (depth_level > max_level) &&
+            (__atomic_compare_exchange_n(&list_branching->max_exploration_level, &max_level, depth_level, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == false) )
+        ;
+}
 
-        for(j=i*c;j<(i*c +c); ++j )
-        {
-            /* I find the number of fractional variables */
-            sum_cur += diag_X[j];
-            sum[i][j%c] = sum_cur;
+branching_open_node_t * MEWCP_find_deepest_element(list_branching_t * list_branching )
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_find_deepest_element *\n");
+#endif
 
+    branching_open_node_t * deepest_element = NULL;
+    branching_open_node_t * element;
 
-            if( (diag_X[j] - 0 ) >= MEWCP_EPSILON )
-            {
-                num_fract_var[i] += 1;
-                fract[i][j%c] = num_fract_var[i];
+#if defined ASSERT
 
-                if (num_fract_var[i] > max_num_fract_var)
-                {
-                    /* I set the maximum fractional number of variables */
-                    max_num_fract_var = num_fract_var[i];
-                }
-            }
-#if defined MEWCP_BRANCHING_DEBUG
-            printf("part: %d id: %d\t diag: %.2lf  sum: %.2lf  fract: %d\n",i,j,diag_X[j],sum[i][j%c], fract[i][j%c]);
+    assert(MEWCP_is_list_branching_empty(list_branching) == false);
 #endif
 
+    /* The sons are pushed to the head, so I start from there */
+    for(element = list_branching->head; element != NULL; element = element->next_branching_node)
+    {
+        if ( (deepest_element == NULL) ||
+             (element->open_node->depth_level > deepest_element->open_node->depth_level) ||
+             ( (element->open_node->depth_level == deepest_element->open_node->depth_level) &&
+               ((element->open_node->DB - deepest_element->open_node->DB) >= MEWCP_EPSILON) ) )
+        {
+            deepest_element = element;
         }
-#if defined MEWCP_BRANCHING_DEBUG
-        printf("\n");
-#endif
-
     }
-    int half_pivot;
-    int candidate_node = -1;
-    int candidate_partition = -1;
-    min_diff = 1;
+    return deepest_element;
+}
 
-    half_pivot = (int) (floor ((float) max_num_fract_var / 2));
-    for (i=0;i<m;++i)
-    {
-        if ( num_fract_var[i] == max_num_fract_var )
-        {
+branching_open_node_t * MEWCP_find_best_estimate_element(list_branching_t * list_branching )
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_find_best_estimate_element *\n");
+#endif
 
-            for(j=0;j<c;++j)
-            {
-                if(fract[i][j] == half_pivot)
-                {
+    branching_open_node_t * best_element = NULL;
+    branching_open_node_t * element;
+    double best_estimate;
 
-                    if( (fabs(sum[i][j] - 0.5) < min_diff) )
-                    {
-                        min_diff = fabs((sum[i][j] - 0.5));
-                        candidate_node = j;
-                        candidate_partition = i;
+    best_estimate = MEWCP_MIN_DOUBLE;
 
-                    }
-                    break;
-                }
-            }
+#if defined ASSERT
 
+    assert(MEWCP_is_list_branching_empty(list_branching) == false);
+#endif
 
-            *out_id_node = (candidate_partition*c) + candidate_node;
-            *out_num_part = candidate_partition;
+    for(element = list_branching->tail; element != NULL; element = element->prev_branching_node)
+    {
+        if( (best_element == NULL) || ((element->open_node->estimate -  best_estimate) >= MEWCP_EPSILON) )
+        {
+            best_estimate = element->open_node->estimate;
+            best_element = element;
         }
-
     }
+    return best_element;
+}
 
-
-
-
-    if ( max_num_fract_var < 2 )
+branching_open_node_t * MEWCP_select_open_node(list_branching_t * list_branching, const unsigned int node_selection)
+{
+    switch (node_selection)
     {
+    case MEWCP_NODE_SELECTION_DEPTH_FIRST:
+        return MEWCP_find_deepest_element(list_branching);
 
-        return false;
-    }
-    else
-    {
-#if defined MEWCP_BRANCHING_DEBUG
-        printf("taken\t part: %d \t node: %d\n",*out_num_part, *out_id_node);
-#endif
+    case MEWCP_NODE_SELECTION_BEST_ESTIMATE:
+        return MEWCP_find_best_estimate_element(list_branching);
 
-        return true;
+    default:
+        /* best first, the hybrid selection jumps to the best bound when its dive ends */
+        return MEWCP_find_worst_bound_element(list_branching);
     }
-
 }
 
+void MEWCP_compute_estimate(open_node_t * open_node, const unsigned int num_nodes, const unsigned int num_partitions)
+{
+    unsigned int i,k;
+    unsigned int cardinality_partition;
+    double max_x;
+    double fractionality = 0;
 
+    cardinality_partition = num_nodes/num_partitions;
 
+    /* Without SDP solution or rounding I can only trust the DB */
+    if ( (open_node->diagX == NULL) || (open_node->PB <= MEWCP_MIN_DOUBLE) || (cardinality_partition < 2) )
+    {
+        open_node->estimate = open_node->DB;
+        return;
+    }
 
-void MEWCP_add_blocked_node(const unsigned int id_node, list_blocked_nodes_t * list_blocked_nodes)
+    /* For each partition 1 - max x_ii is 0 if integer and 1 - 1/c if all equal */
+    for (k=0; k<num_partitions; ++k)
+    {
+        max_x = 0;
+        for (i=k*cardinality_partition; i<(k+1)*cardinality_partition; ++i)
+        {
+            if (open_node->diagX[i] > max_x)
+            {
+                max_x = open_node->diagX[i];
+            }
+        }
+        fractionality += 1 - max_x;
+    }
+    fractionality /= num_partitions * (1 - 1.0/cardinality_partition);
+    if (fractionality > 1)
+    {
+        fractionality = 1;
+    }
+
+    /* an integer diagX gives the DB, a uniform one the rounded PB */
+    open_node->estimate = open_node->DB - (open_node->DB - open_node->PB) * fractionality;
+}
+
+bool MEWCP_is_better_dive_son(open_node_t * son, open_node_t * other_son)
 {
-    unsigned int pos_insertion;
+    if (fabs(son->DB - other_son->DB) > MEWCP_EPSILON)
+    {
+        return (son->DB > other_son->DB);
+    }
+    if (fabs(son->estimate - other_son->estimate) > MEWCP_EPSILON)
+    {
+        return (son->estimate > other_son->estimate);
+    }
 
-    pos_insertion = list_blocked_nodes->num_blocked_nodes;
+    /* Lazy sons have DB and estimate of the father: I keep the side with more of its diagX */
+    return (son->branch_mass <= other_son->branch_mass);
+}
 
-    if (list_blocked_nodes->bool_list[id_node] == false)
+bool MEWCP_is_list_branching_empty(list_branching_t * list_branching)
+{
+    bool is_empty;
+
+    /* I check that pointer to head and tail are NULL */
+
+    if ( (list_branching->head == NULL) &&  ( list_branching->tail == NULL  ) )
     {
-        list_blocked_nodes->bool_list[id_node] = true;
-        list_blocked_nodes->blocked_node[pos_insertion] = id_node;
-        list_blocked_nodes->num_blocked_nodes += 1;
+        is_empty = true;
     }
-#if defined MEWCP_BRANCHING_DEBUG
     else
     {
-        printf("Node: %d is already blocked!\n",id_node);
+        is_empty = false;
+    }
+    return is_empty;
+}
+
+void MEWCP_push_open_node(open_node_t * open_node, list_branching_t * list_branching)
+{
+    /* I insert the element to the head */
+    branching_open_node_t * element;
+    branching_open_node_t * element_tmp;
+
+    /* I create a list element */
+    element = MEWCP_allocate_branching_open_node();
+
+    element->open_node = open_node;
+
+    /* I have to append the element to the head */
+    /* The list is empty */
+    if( MEWCP_is_list_branching_empty(list_branching) == true)
+    {
+        list_branching->head = element;
+        list_branching->tail = element;
+
+        element->prev_branching_node = NULL;
+        element->next_branching_node = NULL;
+    }
+    else /* the list isn't empty */
+    {
+
+        element_tmp = list_branching->head;
+
+        list_branching->head = element;
+
+        element->prev_branching_node = NULL;
+        element->next_branching_node = element_tmp;
+
+        element_tmp->prev_branching_node = element;
+    }
+
+    __atomic_add_fetch(&list_branching->number_open_nodes, 1, __ATOMIC_RELAXED);
+
+
+}
+
+open_node_t * MEWCP_pop_open_node( list_branching_t * list_branching)
+{
+    open_node_t * open_node;
+    branching_open_node_t * element;
+
+#if defined ASSERT
+
+    assert( MEWCP_is_list_branching_empty(list_branching) == false);
+#endif
+
+    /* I extract the element from the tail */
+
+    /* If the element is the first */
+    if ( list_branching->tail->prev_branching_node == NULL)
+    {
+#if defined ASSERT
+        /* The head and the tail point to the same first element */
+        assert(  list_branching->head == list_branching->tail );
+#endif
+
+        element = list_branching->tail;
+        list_branching->head = NULL;
+        list_branching->tail = NULL;
+    }
+    else /* element isn't the first */
+    {
+#if defined ASSERT
+        /* I have at least one previous element  */
+        assert (  list_branching->tail->prev_branching_node != NULL );
+#endif
+
+        element = list_branching->tail;
+
+        list_branching->tail = element->prev_branching_node;
+        list_branching->tail->next_branching_node = NULL;
+
+    }
+
+    open_node = element->open_node;
+    __atomic_sub_fetch(&list_branching->number_open_nodes, 1, __ATOMIC_RELAXED);
+    free(element); /* I only free the element with the pointers but not the open_node structure */
+    return open_node;
+}
+
+open_node_t * MEWCP_pop_specific_open_node(branching_open_node_t * branching_open_node , list_branching_t * list_branching)
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_pop_specific_open_node: %d *\n",branching_open_node->open_node->id_node);
+#endif
+
+    open_node_t * open_node;
+
+#if defined ASSERT
+
+    assert( MEWCP_is_list_branching_empty(list_branching) == false);
+#endif
+
+    /* I extract the given  branching_open_node element from the list */
+
+    /* If the element is the only element in the list */
+
+    if ( (branching_open_node->prev_branching_node == NULL) && ( branching_open_node->next_branching_node == NULL) )
+    {
+#if defined ASSERT
+        /* The head and the tail point to the same first element */
+        assert(  list_branching->head == list_branching->tail );
+        assert(  list_branching->head ==  branching_open_node);
+
+#endif
+
+        list_branching->head = NULL;
+        list_branching->tail = NULL;
+    }
+    else if (branching_open_node->prev_branching_node == NULL) /* element is the first but not the only*/
+    {
+#if defined ASSERT
+        /* I have at least one follow element  */
+        assert (  list_branching->head == branching_open_node);
+        assert ( branching_open_node->next_branching_node != NULL );
+#endif
+
+        list_branching->head = branching_open_node->next_branching_node;
+        list_branching->head->prev_branching_node = NULL;
+
+
+    }
+    else if (branching_open_node->next_branching_node == NULL) /* element is the last but not the only*/
+    {
+#if defined ASSERT
+        /* I have at least one follow element  */
+        assert (  list_branching->tail == branching_open_node);
+        assert ( branching_open_node->prev_branching_node != NULL );
+#endif
+
+        list_branching->tail = branching_open_node->prev_branching_node;
+        list_branching->tail->next_branching_node = NULL;
+    }
+    else /* Element is not the tail nor the head of the list */
+    {
+#if defined ASSERT
+
+        assert ( branching_open_node->prev_branching_node != NULL );
+        assert ( branching_open_node->next_branching_node != NULL );
+#endif
+
+        branching_open_node->prev_branching_node->next_branching_node = branching_open_node->next_branching_node;
+        branching_open_node->next_branching_node->prev_branching_node = branching_open_node->prev_branching_node;
+    }
+
+    open_node = branching_open_node->open_node;
+    __atomic_sub_fetch(&list_branching->number_open_nodes, 1, __ATOMIC_RELAXED);
+    free(branching_open_node); /* I only free the element with the pointers but not the open_node structure */
+    return open_node;
+}
+
 
+void MEWCP_generate_list_blocked_nodes_branching_sons(list_blocked_nodes_t * father_blocked_nodes,
+        list_blocked_nodes_t * left_son_blocked_nodes,
+        list_blocked_nodes_t * right_son_blocked_nodes,
+        const int branch_num_part,
+        const int branch_id_node,
+        const unsigned int num_nodes,
+        const unsigned int cardinality_partition )
+{
+    int  boundaries[4];
+    int i;
+
+
+    /* As first thing I clone the father blocked list */
+    MEWCP_clone_list_blocked_modes(father_blocked_nodes, left_son_blocked_nodes,num_nodes);
+    MEWCP_clone_list_blocked_modes(father_blocked_nodes, right_son_blocked_nodes,num_nodes);
+
+    /* I consider left son the one with nodes blocked on the right of branch_id_node in the same partition */
+    /* I consider right son the one with nodes blocked on the left of branch_id_node (also blocked) in the same partition */
+
+    /* [ left-son +| branch_id_node || 0 | 0 | 0 ]
+     * [ 0 | 0 | 0 | branch_id_node || right-son ]
+     */
+
+    /* I have in boundaries[0]=a and boundaries[1]=b   [a  X  X  X  b] */
+    trova_boundaries_diagonale(cardinality_partition,branch_id_node,boundaries);
+
+    /* I fill in the right son first */
+    for(i=boundaries[0]; i<= branch_id_node; ++i )
+    {
+        MEWCP_add_blocked_node(i,right_son_blocked_nodes);
+    }
+    /* Now, I fill in the left son */
+    for(i=branch_id_node+1; i<= boundaries[1]; ++i )
+    {
+        MEWCP_add_blocked_node(i,left_son_blocked_nodes);
+    }
+
+}
+
+bool MEWCP_generate_equi_branch_node(double * diag_X, const unsigned int n, const unsigned int m,  int * out_num_part,  int * out_id_node)
+{
+#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
+    printf("* MEWCP_generate_equi_branch_node *\n");
+#endif
+
+    unsigned int i,j,c;
+    double sum_partition[m];
+    int  id_node_part[m];
+    int num_fract_var[m];
+    double min_diff;
+    double cur_min_diff;
+
+    double  sum_cur;
+    int max_num_fract_var =0;
+
+    c = n/m;
+
+    for(i=0;i<m;++i)
+    {
+
+        cur_min_diff = 1;
+        sum_cur = 0;
+
+        num_fract_var[i] = 0;
 
+
+        for(j=i*c;j<(i*c +c); ++j )
+        {
+            /* I find the number of fractional variables */
+            sum_cur += diag_X[j];
+
+
+            if ( (fabs(sum_cur - 0.5) < cur_min_diff) && (diag_X[j] > MEWCP_EPSILON )  && ( (1.0 - diag_X[j])  > MEWCP_EPSILON)  )
+            {
+                cur_min_diff = fabs(sum_cur - 0.5);
+
+                id_node_part[i] = j;
+                sum_partition[i] = sum_cur;
+
+                num_fract_var[i] += 1;
+
+                if (num_fract_var[i] > max_num_fract_var)
+                {
+                    /* I set the maximum fractional number of variables */
+                    max_num_fract_var = num_fract_var[i];
+                }
+
+            }
+#if defined MEWCP_BRANCHING_DEBUG
+
+            printf("Part: %d \t diag[%d]: %.5lf \t Sum: %.5lf num_fract: %d\n",i,j,diag_X[j],sum_cur,num_fract_var[i]);
+#endif
+
+        }
+#if defined MEWCP_BRANCHING_DEBUG
+        printf("Ho preso: %d \t somma: %.2lf\n",id_node_part[i],sum_partition[i]);
+#endif
+
+    }
+    min_diff = 1;
+    for (i=0;i<m;++i)
+    {
+        if ( num_fract_var[i] == max_num_fract_var )
+        {
+
+
+
+            /* I take the partition node nearest to sum 0.5 */
+
+            if (  ( fabs(sum_partition[i] - 0.5) < min_diff)   )
+            {
+
+
+                min_diff = fabs(sum_partition[i] - 0.5);
+#if defined MEWCP_BRANCHING_DEBUG
+
+                printf("sum_part[%d]: %.2lf \t mindiff: %.2lf\n",i,sum_partition[i], min_diff);
+#endif
+
+                *out_id_node = id_node_part[i];
+                *out_num_part = i;
+            }
+
+        }
+    }
+
+
+
+    if ( max_num_fract_var < 1 )
+    {
+
+        return false;
+    }
+    else
+    {
+#if defined MEWCP_BRANCHING_DEBUG
+        printf("taken\t part: %d \t node: %d\n",*out_num_part, *out_id_node);
+#endif
+
+        return true;
+    }
+
+}
+
+bool MEWCP_generate_perfect_equi_branch(double * diag_X, const unsigned int n, const unsigned int m,  int * out_num_part,  int * out_id_node)
+{
+#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
+    printf("* MEWCP_generate_perfect_equi_branch_node *\n");
+#endif
+
+
+    unsigned int i,j,c;
+    double sum_partition[m];
+    int  id_node_part[m];
+    int num_fract_var[m];
+    double min_diff;
+    double cur_min_diff;
+
+    double  sum_cur;
+    int max_num_fract_var =0;
+
+    c = n/m;
+
+    for(i=0;i<m;++i)
+    {
+
+        cur_min_diff = 1;
+        sum_cur = 0;
+
+        num_fract_var[i] = 0;
+
+
+        for(j=i*c;j<(i*c +c); ++j )
+        {
+            /* I find the number of fractional variables */
+            sum_cur += diag_X[j];
+
+
+            if( (diag_X[j] - 0 ) >= MEWCP_EPSILON )
+            {
+                num_fract_var[i] += 1;
+
+                if (num_fract_var[i] > max_num_fract_var)
+                {
+                    /* I set the maximum fractional number of variables */
+                    max_num_fract_var = num_fract_var[i];
+                }
+            }
+
+
+
+
+
+            if ( fabs(sum_cur - 0.5) < cur_min_diff )
+            {
+                cur_min_diff = fabs(sum_cur - 0.5);
+
+                id_node_part[i] = j;
+                sum_partition[i] = sum_cur;
+
+            }
+#if defined MEWCP_BRANCHING_DEBUG
+
+            printf("Part: %d \t diag[%d]: %.4lf \t Sum: %.2lf num_fract: %d\n",i,j,diag_X[j],sum_cur,num_fract_var[i]);
+#endif
+
+        }
+#if defined MEWCP_BRANCHING_DEBUG
+        printf("Ho preso: %d \t somma: %.2lf\n",id_node_part[i],sum_partition[i]);
+#endif
+
+    }
+    min_diff = 1;
+    for (i=0;i<m;++i)
+    {
+        if ( num_fract_var[i] == max_num_fract_var )
+        {
+
+
+
+            /* I take the partition node nearest to sum 0.5 */
+
+            if (  ( fabs(sum_partition[i] - 0.5) < min_diff)   )
+            {
+
+
+                min_diff = fabs(sum_partition[i] - 0.5);
+#if defined MEWCP_BRANCHING_DEBUG
+
+                printf("sum_part[%d]: %.2lf \t mindiff: %.2lf\n",i,sum_partition[i], min_diff);
+#endif
+
+                *out_id_node = id_node_part[i];
+                *out_num_part = i;
+            }
+
+        }
+    }
+
+
+
+    if ( max_num_fract_var < 2 )
+    {
+
+        return false;
+    }
+    else
+    {
+#if defined MEWCP_BRANCHING_DEBUG
+        printf("taken\t part: %d \t node: %d\n",*out_num_part, *out_id_node);
+#endif
+
+        return true;
+    }
+}
+
+/*
+ * I select the partition with the most number of fractional variables
+ * I take the element that divides the partition in 2 equi number of fractional
+ * If I have more than one partition with the same max number of fract variables I take the one with pivot element having nearest sum to 1/2
+ */
+bool MEWCP_generate_max_fractional_branch(double * diag_X, const unsigned int n, const unsigned int m,  int * out_num_part,  int * out_id_node)
+{
+#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
+    printf("* MEWCP_generate_max_fractional_branch *\n");
+#endif
+
+
+    unsigned int i,j,c;
+
+
+    int num_fract_var[m];
+    double min_diff;
+
+
+    double  sum_cur;
+    int max_num_fract_var =0;
+
+    c = n/m;
+    int fract[m][c];  // number of fractional varibles until that node
+    double sum[m][c];  //density until that element
+
+    /* I have to clean the vectors */
+    for(i=0;i<m;++i)
+    {
+        for (j = 0; j < c; ++j)
+        {
+            fract[i][j] = 0;
+            sum[i][j] = 0.0;
+        }
+    }
+
+
+    for(i=0;i<m;++i)
+    {
+
+
+        sum_cur = 0;
+
+        num_fract_var[i] = 0;
+
+
+        for(j=i*c;j<(i*c +c); ++j )
+        {
+            /* I find the number of fractional variables */
+            sum_cur += diag_X[j];
+            sum[i][j%c] = sum_cur;
+
+
+            if( (diag_X[j] - 0 ) >= MEWCP_EPSILON )
+            {
+                num_fract_var[i] += 1;
+                fract[i][j%c] = num_fract_var[i];
+
+                if (num_fract_var[i] > max_num_fract_var)
+                {
+                    /* I set the maximum fractional number of variables */
+                    max_num_fract_var = num_fract_var[i];
+                }
+            }
+#if defined MEWCP_BRANCHING_DEBUG
+            printf("part: %d id: %d\t diag: %.2lf  sum: %.2lf  fract: %d\n",i,j,diag_X[j],sum[i][j%c], fract[i][j%c]);
+#endif
+
+        }
+#if defined MEWCP_BRANCHING_DEBUG
+        printf("\n");
+#endif
+
+    }
+    int half_pivot;
+    int candidate_node = -1;
+    int candidate_partition = -1;
+    min_diff = 1;
+
+    half_pivot = (int) (floor ((float) max_num_fract_var / 2));
+    for (i=0;i<m;++i)
+    {
+        if ( num_fract_var[i] == max_num_fract_var )
+        {
+
+            for(j=0;j<c;++j)
+            {
+                if(fract[i][j] == half_pivot)
+                {
+
+                    if( (fabs(sum[i][j] - 0.5) < min_diff) )
+                    {
+                        min_diff = fabs((sum[i][j] - 0.5));
+                        candidate_node = j;
+                        candidate_partition = i;
+
+                    }
+                    break;
+                }
+            }
+
+
+            *out_id_node = (candidate_partition*c) + candidate_node;
+            *out_num_part = candidate_partition;
+        }
+
+    }
+
+
+
+
+    if ( max_num_fract_var < 2 )
+    {
+
+        return false;
+    }
+    else
+    {
+#if defined MEWCP_BRANCHING_DEBUG
+        printf("taken\t part: %d \t node: %d\n",*out_num_part, *out_id_node);
+#endif
+
+        return true;
+    }
+
+}
+
+
+
+
+/*
+ * Reliability branching: the candidates are all the split nodes of the partitions with at least
+ * 2 fractional variables that leave some fractional mass on both sides.
+ * The DB degradation of a son is estimated as pseudo-cost * fractional mass removed, the split with
+ * the best product of the two degradations is taken.
+ * Splits not yet reliable are evaluated with the combinatorial bound of the two sons (the cheapest
+ * ones, most balanced first), and the observations go into the pseudo-costs.
+ */
+bool MEWCP_generate_pseudo_cost_branch(open_node_t * open_node, pseudo_costs_t * pseudo_costs, matrix_weights_t * matrix_weights,
+                                       bound_workspace_t * workspace,
+                                       const unsigned int n, const unsigned int m,  int * out_num_part,  int * out_id_node)
+{
+#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
+    printf("* MEWCP_generate_pseudo_cost_branch *\n");
+#endif
+
+    unsigned int i,j,c;
+    int k,h;
+    double * diag_X = open_node->diagX;
+
+    double sum_partition;
+    double sum_cur;
+    int num_fract_var;
+
+    /* Candidate splits, in the workspace */
+    int num_candidates = 0;
+    int * candidate_node = workspace->candidate_node;
+    int * candidate_part = workspace->candidate_part;
+    double * candidate_mass_left = workspace->candidate_mass_left;    /* mass kept by the left son, removed in the right one */
+    double * candidate_mass_right = workspace->candidate_mass_right;
+    double * candidate_gain_left = workspace->candidate_gain_left;
+    double * candidate_gain_right = workspace->candidate_gain_right;
+    bool * candidate_reliable = workspace->candidate_reliable;
+
+    double pc_all;
+    double pc_left;
+    double pc_right;
+    int num_strong;
+    int best_strong;
+    double father_DB_comb;
+
+    double score;
+    double best_score;
+
+    c = n/m;
+
+    for(i=0;i<m;++i)
+    {
+        sum_partition = 0;
+        num_fract_var = 0;
+        for(j=i*c;j<(i*c +c); ++j )
+        {
+            sum_partition += diag_X[j];
+            if( (diag_X[j] - 0 ) >= MEWCP_EPSILON )
+            {
+                num_fract_var += 1;
+            }
+        }
+
+        if (num_fract_var < 2)
+        {
+            continue;
+        }
+
+        sum_cur = 0;
+        for(j=i*c;j<(i*c +c -1); ++j )
+        {
+            sum_cur += diag_X[j];
+            if ( (sum_cur >= MEWCP_EPSILON) && ((sum_partition - sum_cur) >= MEWCP_EPSILON) )
+            {
+                candidate_node[num_candidates] = j;
+                candidate_part[num_candidates] = i;
+                candidate_mass_left[num_candidates] = sum_cur;
+                candidate_mass_right[num_candidates] = sum_partition - sum_cur;
+                ++num_candidates;
+            }
+        }
+    }
+
+    if (num_candidates == 0)
+    {
+        return false;
+    }
+
+    /* Degradations from the pseudo-costs, a side never observed takes the average of all the splits */
+    pthread_mutex_lock(&pseudo_costs->mutex);
+
+    pc_all = 1;
+    if (pseudo_costs->count_all > 0)
+    {
+        pc_all = pseudo_costs->sum_all / pseudo_costs->count_all;
+    }
+
+    for (k=0; k<num_candidates; ++k)
+    {
+        j = candidate_node[k];
+
+        pc_left = pc_all;
+        if (pseudo_costs->count_left[j] > 0)
+        {
+            pc_left = pseudo_costs->sum_left[j] / pseudo_costs->count_left[j];
+        }
+        pc_right = pc_all;
+        if (pseudo_costs->count_right[j] > 0)
+        {
+            pc_right = pseudo_costs->sum_right[j] / pseudo_costs->count_right[j];
+        }
+
+        candidate_gain_left[k] = pc_left * candidate_mass_right[k];
+        candidate_gain_right[k] = pc_right * candidate_mass_left[k];
+
+        candidate_reliable[k] = (pseudo_costs->count_left[j] >= MEWCP_RELIABILITY_THRESHOLD) &&
+                                (pseudo_costs->count_right[j] >= MEWCP_RELIABILITY_THRESHOLD);
+    }
+
+    pthread_mutex_unlock(&pseudo_costs->mutex);
+
+    /* Strong branching on the most balanced unreliable splits */
+    father_DB_comb = open_node->DB_comb;
+    for (num_strong=0; num_strong < MEWCP_STRONG_BRANCHING_CANDIDATES; ++num_strong)
+    {
+        best_strong = -1;
+        for (k=0; k<num_candidates; ++k)
+        {
+            if ( candidate_reliable[k] == false && ( best_strong == -1 ||
+                    fabs(candidate_mass_left[k] - candidate_mass_right[k]) < fabs(candidate_mass_left[best_strong] - candidate_mass_right[best_strong]) ) )
+            {
+                best_strong = k;
+            }
+        }
+
+        if (best_strong == -1)
+        {
+            break;
+        }
+
+        /* The combinatorial bound of the father is needed only once */
+        if (father_DB_comb == 0)
+        {
+            father_DB_comb = MEWCP_combinatorial_bound_blocked_nodes(open_node->list_blocked_nodes,open_node->combinatorial_cache,workspace,matrix_weights,n,m);
+        }
+
+        MEWCP_strong_branching_combinatorial(open_node,pseudo_costs,matrix_weights,workspace,father_DB_comb,
+                                             candidate_mass_left[best_strong],candidate_mass_right[best_strong],
+                                             candidate_part[best_strong],candidate_node[best_strong],n,m,
+                                             &candidate_gain_left[best_strong],&candidate_gain_right[best_strong]);
+
+        /* Evaluated, I don't take it again */
+        candidate_reliable[best_strong] = true;
+    }
+
+    /* Product score */
+    best_score = -1;
+    h = 0;
+    for (k=0; k<num_candidates; ++k)
+    {
+        pc_left = (candidate_gain_left[k] > MEWCP_PSEUDO_COST_MIN_GAIN) ? candidate_gain_left[k] : MEWCP_PSEUDO_COST_MIN_GAIN;
+        pc_right = (candidate_gain_right[k] > MEWCP_PSEUDO_COST_MIN_GAIN) ? candidate_gain_right[k] : MEWCP_PSEUDO_COST_MIN_GAIN;
+        score = pc_left * pc_right;
+#if defined MEWCP_BRANCHING_DEBUG
+        printf("Split part: %d \t node: %d \t gain left: %.4lf \t gain right: %.4lf \t score: %.4lf\n",candidate_part[k],candidate_node[k],candidate_gain_left[k],candidate_gain_right[k],score);
+#endif
+        if (score > best_score)
+        {
+            best_score = score;
+            h = k;
+        }
+    }
+
+    *out_num_part = candidate_part[h];
+    *out_id_node = candidate_node[h];
+
+#if defined MEWCP_BRANCHING_DEBUG
+    printf("taken\t part: %d \t node: %d\n",*out_num_part, *out_id_node);
+#endif
+
+    return true;
+}
+
+void MEWCP_strong_branching_combinatorial(open_node_t * open_node, pseudo_costs_t * pseudo_costs, matrix_weights_t * matrix_weights,
+        bound_workspace_t * workspace, const double father_DB_comb, const double mass_left, const double mass_right,
+        const int num_part, const int split_node, const unsigned int n, const unsigned int m,
+        double * out_gain_left, double * out_gain_right)
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_strong_branching_combinatorial *\n");
+#endif
+
+    list_blocked_nodes_t * left_blocked_nodes;
+    list_blocked_nodes_t * right_blocked_nodes;
+
+    left_blocked_nodes = workspace->left_blocked_nodes;
+    right_blocked_nodes = workspace->right_blocked_nodes;
+
+    MEWCP_generate_list_blocked_nodes_branching_sons(open_node->list_blocked_nodes,left_blocked_nodes,right_blocked_nodes,num_part,split_node,n,n/m);
+
+    /* The bound of a son can't be worse than the father's one, up to the rounding */
+    *out_gain_left = father_DB_comb - MEWCP_combinatorial_bound_blocked_nodes(left_blocked_nodes,open_node->combinatorial_cache,workspace,matrix_weights,n,m);
+    *out_gain_right = father_DB_comb - MEWCP_combinatorial_bound_blocked_nodes(right_blocked_nodes,open_node->combinatorial_cache,workspace,matrix_weights,n,m);
+    if (*out_gain_left < 0)
+    {
+        *out_gain_left = 0;
+    }
+    if (*out_gain_right < 0)
+    {
+        *out_gain_right = 0;
+    }
+
+    /* The left son removes the mass on the right of the split */
+    MEWCP_add_pseudo_cost(pseudo_costs,split_node,true,*out_gain_left / mass_right);
+    MEWCP_add_pseudo_cost(pseudo_costs,split_node,false,*out_gain_right / mass_left);
+}
+
+double MEWCP_combinatorial_bound_blocked_nodes(list_blocked_nodes_t * list_blocked_nodes, const combinatorial_cache_t * start_cache,
+        bound_workspace_t * workspace, matrix_weights_t * matrix_weights, const unsigned int n, const unsigned int m)
+{
+    open_node_t * probe_node;
+
+    /* A node without SDP data, only the combinatorial bound is computed on it */
+    probe_node = workspace->probe_node;
+    MEWCP_clone_list_blocked_modes(list_blocked_nodes,probe_node->list_blocked_nodes,n);
+    MEWCP_copy_combinatorial_cache(start_cache,probe_node->combinatorial_cache);
+    probe_node->DB = (double) MEWCP_MAX_DOUBLE;
+    probe_node->PB = (double) MEWCP_MIN_DOUBLE;
+
+    MEWCP_bound_combinatorial(probe_node,workspace,matrix_weights,m,n/m,MEWCP_MIN_DOUBLE);
+
+    return probe_node->DB_comb;
+}
+
+void MEWCP_add_pseudo_cost(pseudo_costs_t * pseudo_costs, const int split_node, const bool is_left, const double unit_gain)
+{
+    pthread_mutex_lock(&pseudo_costs->mutex);
+
+    if (is_left == true)
+    {
+        pseudo_costs->sum_left[split_node] += unit_gain;
+        pseudo_costs->count_left[split_node] += 1;
+    }
+    else
+    {
+        pseudo_costs->sum_right[split_node] += unit_gain;
+        pseudo_costs->count_right[split_node] += 1;
+    }
+    pseudo_costs->sum_all += unit_gain;
+    pseudo_costs->count_all += 1;
+
+    pthread_mutex_unlock(&pseudo_costs->mutex);
+}
+
+void MEWCP_update_pseudo_costs(pseudo_costs_t * pseudo_costs, open_node_t * son)
+{
+    double gain;
+
+    if ( (pseudo_costs == NULL) || (son->branch_split_node < 0) || (son->branch_mass < MEWCP_EPSILON) )
+    {
+        return;
+    }
+
+    /* An infeasible son has no meaningful DB */
+    if ( (son->DB <= MEWCP_MIN_DOUBLE) || (son->DB >= MEWCP_MAX_DOUBLE) )
+    {
+        return;
+    }
+
+    gain = son->father_DB - son->DB;
+    if (gain < 0)
+    {
+        gain = 0;
+    }
+
+    MEWCP_add_pseudo_cost(pseudo_costs,son->branch_split_node,son->branch_is_left,gain / son->branch_mass);
+}
+
+void MEWCP_add_blocked_node(const unsigned int id_node, list_blocked_nodes_t * list_blocked_nodes)
+{
+    unsigned int pos_insertion;
+
+    pos_insertion = list_blocked_nodes->num_blocked_nodes;
+
+    if (list_blocked_nodes->bool_list[id_node] == false)
+    {
+        list_blocked_nodes->bool_list[id_node] = true;
+        list_blocked_nodes->blocked_node[pos_insertion] = id_node;
+        list_blocked_nodes->num_blocked_nodes += 1;
+    }
+#if defined MEWCP_BRANCHING_DEBUG
+    else
+    {
+        printf("Node: %d is already blocked!\n",id_node);
+
+
+    }
+#endif
+
+    /* All structures are updated */
+}
+
+double MEWCP_evaluate_list_nodes_solution(int * list_node_solution, matrix_weights_t * matrix_weights ,const unsigned int m)
+{
+#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
+    printf("* MEWCP_evaluate_list_nodes_solution *\n");
+#endif
+
+    unsigned int i,j;
+
+    double z_tmp;
+    int pos_i;
+    int pos_j;
+
+    z_tmp = 0;
+
+
+
+    for (i=0;i<m;++i)
+    {
+        for(j=i; j<m;++j)
+        {
+            pos_i = list_node_solution[i];
+            pos_j = list_node_solution[j];
+            z_tmp += (double) matrix_weights->weight[pos_i][pos_j];
+        }
+    }
+#if defined MEWCP_CONVERTER_DSDP_DEBUG
+    printf("Objective value of node_list: %.2lf\n",z_tmp);
+#endif
+
+    return z_tmp;
+}
+
+void MEWCP_evaluate_list_nodes_solutions(const int * solutions, const unsigned int num_solutions,
+        matrix_weights_t * matrix_weights,
+        const unsigned int m,
+        double * out_values)
+{
+    unsigned int i,j,s,n;
+    const weight_t * weights;
+    const int * nodes_i;
+    const int * nodes_j;
+
+    n = matrix_weights->n;
+    weights = matrix_weights->weight[0];	/* all the rows, see MEWCP_create_matrix_weights */
+
+    for (s=0; s<num_solutions; ++s)
+    {
+        out_values[s] = 0;
+    }
+
+    /* The solutions are the inner loop: the nodes of a partition are contiguous, the weights are gathered */
+    for (i=0; i<m; ++i)
+    {
+        nodes_i = &solutions[i*num_solutions];
+        for (j=i; j<m; ++j)
+        {
+            nodes_j = &solutions[j*num_solutions];
+            for (s=0; s<num_solutions; ++s)
+            {
+                out_values[s] += (double) weights[nodes_i[s]*n + nodes_j[s]];
+            }
+        }
+    }
+}
+
+double MEWCP_evaluate_sdp_roundings(double * diag_X, int * list_nodes_rounded, list_blocked_nodes_t * list_blocked_nodes,
+        bound_workspace_t * workspace,
+        matrix_weights_t * matrix_weights,
+        const unsigned int m,
+        const unsigned int c)
+{
+    unsigned int k,t,s,j;
+    unsigned int num_solutions;
+    int second;
+    int best_s;
+    int * solutions = workspace->rounding_solutions;
+    double * values = workspace->rounding_values;
+
+    /* The solution 0 is the rounding, the solution k+1 has the second choice of the partition k */
+    num_solutions = m + 1;
+    for (s=0; s<num_solutions; ++s)
+    {
+        for (t=0; t<m; ++t)
+        {
+            solutions[t*num_solutions + s] = list_nodes_rounded[t];
+        }
+    }
+    for (k=0; k<m; ++k)
+    {
+        second = -1;
+        for (j=k*c; j<(k*c + c); ++j)
+        {
+            if ( ((int) j == list_nodes_rounded[k]) || (list_blocked_nodes->bool_list[j] == true) )
+            {
+                continue;
+            }
+            if ( (second == -1) || ((diag_X[j] - diag_X[second]) > MEWCP_EPSILON) )
+            {
+                second = j;
+            }
+        }
+        if (second != -1)
+        {
+            solutions[k*num_solutions + k+1] = second;
+        }
+    }
+
+    MEWCP_evaluate_list_nodes_solutions(solutions,num_solutions,matrix_weights,m,values);
+
+    best_s = 0;
+    for (s=1; s<num_solutions; ++s)
+    {
+        if ((values[s] - values[best_s]) > MEWCP_EPSILON)
+        {
+            best_s = s;
+        }
+    }
+    for (t=0; t<m; ++t)
+    {
+        list_nodes_rounded[t] = solutions[t*num_solutions + best_s];
+    }
+
+    return values[best_s];
+}
+
+void MEWCP_evaluate_partition_alternatives(int * list_node_solution, const double z_solution,
+        matrix_weights_t * matrix_weights,
+        const unsigned int m,
+        const unsigned int c,
+        const unsigned int k,
+        double * out_values)
+{
+    unsigned int t,r;
+    unsigned int first;
+    weight_t * row;
+    double value_current;
+
+    first = k*c;
+
+    /* The vertex costs are on the diagonal */
+    for (r=0; r<c; ++r)
+    {
+        out_values[r] = matrix_weights->weight[first + r][first + r];
+    }
+
+    /* The matrix is symmetric: the edges of all the alternatives towards a taken node are a piece of its row */
+    for (t=0; t<m; ++t)
+    {
+        if (t == k)
+        {
+            continue;
+        }
+        row = &matrix_weights->weight[list_node_solution[t]][first];
+        for (r=0; r<c; ++r)
+        {
+            out_values[r] += row[r];
+        }
+    }
+
+    value_current = out_values[list_node_solution[k] - first];
+    for (r=0; r<c; ++r)
+    {
+        out_values[r] += z_solution - value_current;
+    }
+}
+
+double MEWCP_improve_list_nodes_solution(int * list_node_solution, const double z_solution,
+        list_blocked_nodes_t * list_blocked_nodes,
+        matrix_weights_t * matrix_weights,
+        const unsigned int m,
+        const unsigned int c,
+        double * values)
+{
+    unsigned int k,r;
+    unsigned int num_not_improved;
+    int best_r;
+    double z;
+    double z_best;
+
+    z = z_solution;
+
+    /* A partition at a time, until none of them has a better node */
+    k = 0;
+    num_not_improved = 0;
+    while (num_not_improved < m)
+    {
+        MEWCP_evaluate_partition_alternatives(list_node_solution,z,matrix_weights,m,c,k,values);
+
+        best_r = -1;
+        z_best = z;
+        for (r=0; r<c; ++r)
+        {
+            if ( (list_blocked_nodes->bool_list[k*c + r] == false) && ((values[r] - z_best) > MEWCP_EPSILON) )
+            {
+                z_best = values[r];
+                best_r = r;
+            }
+        }
+
+        if (best_r == -1)
+        {
+            num_not_improved++;
+        }
+        else
+        {
+            list_node_solution[k] = k*c + best_r;
+            z = z_best;
+            num_not_improved = 1;
+        }
+        k = (k + 1) % m;
+    }
+
+    return z;
+}
+
+unsigned int MEWCP_count_solution_conflicts(int * list_node_solution, matrix_weights_t * matrix_weights ,const unsigned int m)
+{
+    unsigned int i,j;
+    unsigned int num_conflicts = 0;
+
+    if (matrix_weights->conflict_start == NULL)
+    {
+        return 0;
+    }
+
+    for (i=0;i<m;++i)
+    {
+        for(j=i+1; j<m;++j)
+        {
+            if (MEWCP_is_conflict(matrix_weights,list_node_solution[i],list_node_solution[j]) == true)
+            {
+                num_conflicts++;
+            }
+        }
+    }
+
+    return num_conflicts;
+}
+
+const unsigned int * MEWCP_get_node_conflicts(const matrix_weights_t * matrix_weights, const unsigned int i, unsigned int * out_num_conflicts)
+{
+    if (matrix_weights->conflict_start == NULL)
+    {
+        *out_num_conflicts = 0;
+        return NULL;
+    }
+
+    *out_num_conflicts = matrix_weights->conflict_start[i+1] - matrix_weights->conflict_start[i];
+    return &matrix_weights->conflict_nodes[matrix_weights->conflict_start[i]];
+}
+
+bool MEWCP_is_conflict(const matrix_weights_t * matrix_weights, const unsigned int i, const unsigned int j)
+{
+    const unsigned int * row;
+    unsigned int num_row;
+    unsigned int low,high,middle;
+
+    row = MEWCP_get_node_conflicts(matrix_weights,i,&num_row);
+
+    /* The row is sorted */
+    low = 0;
+    high = num_row;
+    while (low < high)
+    {
+        middle = (low + high)/2;
+        if (row[middle] < j)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return (low < num_row) && (row[low] == j);
+}
+
+int sort_compare (const void * a, const void * b)
+{
+    return ( *(int*)a - *(int*)b );
+
+}
+
+void Take_Time(double * user_time, double * system_time)
+{
+    struct tms buff;
+    times(&buff);
+    *system_time = buff.tms_stime;
+    *user_time = buff.tms_utime;
+    *system_time /= 100;
+    *user_time /= 100;
+    
+    
+}
+
+double get_cpu_time(void)
+{
+	double user_time;
+	double  system_time;
+	struct tms buff;
+    
+    times(&buff);
+    system_time = buff.tms_stime;
+    user_time = buff.tms_utime;
+    system_time /= 100;
+    user_time /= 100;
+    
+    return user_time + system_time; 
+	
+}
+
+double get_thread_cpu_time(void)
+{
+    struct timespec time_spec;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time_spec);
+    return time_spec.tv_sec + time_spec.tv_nsec / 1E9;
+}
+
+double get_wall_time(void)
+{
+    struct tms buff;
+
+    /* times returns the clock ticks elapsed since an arbitrary point */
+    return ((double) times(&buff)) / 100;
+}
+
+open_node_t * MEWCP_allocate_open_node(void)
+{
+    open_node_t * open_node;
+
+    open_node = (open_node_t *) calloc(1,sizeof (open_node_t));
+    if ( open_node == NULL)
+    {
+        printf("!!! ERROR allocation open_node! \n");
+        exit(EXIT_FAILURE);
+    }
+
+    open_node->id_node = -1;
+    open_node->DB = (double) MEWCP_MAX_DOUBLE;
+    open_node->PB = (double) MEWCP_MIN_DOUBLE;
+    open_node->estimate = (double) MEWCP_MAX_DOUBLE;
+    open_node->branch_split_node = -1;
+    open_node->is_bounded = false;
+
+
+
+    open_node->list_nodes_solution = NULL;
+    open_node->diagX = NULL;
+    open_node->list_blocked_nodes = NULL;
+    open_node->vect_mat_branching_contraint = NULL;
+    open_node->pair_bounds = NULL;
+    open_node->lagrangian_multipliers = NULL;
+    open_node->combinatorial_cache = NULL;
+
+    return open_node;
+
+}
+
+solution_bb_t * MEWCP_allocate_solution_bb(unsigned int num_partitions)
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_allocate_solution_bb *\n");
+#endif
+
+    solution_bb_t * solution_bb;
+
+    solution_bb = ( solution_bb_t *) calloc(1,sizeof(solution_bb_t) );
+    if ( solution_bb == NULL)
+    {
+        printf("!!! ERROR allocation MEWCP_allocate_solution_bb! \n");
+        exit(EXIT_FAILURE);
+    }
+
+    solution_bb->list_nodes_best_solution= MEWCP_allocate_list_nodes_solution(num_partitions);
+
+    return solution_bb;
+
+}
+
+
+sdp_reduction_t * MEWCP_allocate_sdp_reduction(constraint_t * constraints_matrix,
+        const unsigned int num_constraints,
+        const unsigned int num_nodes)
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_allocate_sdp_reduction *\n");
+#endif
+
+    unsigned int i;
+    unsigned int total_nz;
+    sdp_reduction_t * reduction;
+
+    reduction = (sdp_reduction_t *) calloc(1, sizeof(sdp_reduction_t));
+    if ( reduction == NULL)
+    {
+        printf("!!! ERROR allocation reduction! \n");
+        exit(EXIT_FAILURE);
+    }
+    reduction->num_nodes = num_nodes;
+
+    reduction->reduced_node = (int *) calloc(num_nodes, sizeof(int));
+    reduction->kept = (unsigned int *) calloc(num_constraints+1, sizeof(unsigned int));
+    reduction->constraints = (constraint_t *) calloc(num_constraints+1, sizeof(constraint_t));
+    reduction->bi = (double *) calloc(num_constraints, sizeof(double));
+    reduction->vect_y = (double *) calloc(num_constraints, sizeof(double));
+    reduction->diagonal_position = (int *) calloc(num_nodes, sizeof(int));
+    reduction->diagonal_touched = (int *) calloc(num_nodes, sizeof(int));
+    reduction->is_fixed = (bool *) calloc(num_nodes, sizeof(bool));
+    if ( (reduction->reduced_node == NULL) || (reduction->kept == NULL) || (reduction->constraints == NULL) ||
+            (reduction->bi == NULL) || (reduction->vect_y == NULL) || (reduction->diagonal_position == NULL) ||
+            (reduction->diagonal_touched == NULL) || (reduction->is_fixed == NULL) )
+    {
+        printf("!!! ERROR allocation reduction arrays! \n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* The restricted matrices are not larger than the original ones, the branching one has the diagonal of the blocked nodes */
+    total_nz = num_nodes;
+    for (i=0; i<num_constraints; ++i)
+    {
+        total_nz += constraints_matrix[i].num_nz;
+    }
+    reduction->index_storage = (int *) calloc(total_nz+1, sizeof(int));
+    reduction->weight_storage = (double *) calloc(total_nz+1, sizeof(double));
+    if ( (reduction->index_storage == NULL) || (reduction->weight_storage == NULL) )
+    {
+        printf("!!! ERROR allocation reduction storage! \n");
+        exit(EXIT_FAILURE);
+    }
+
+    return reduction;
+}
+
+void MEWCP_reduce_sdp_problem(sdp_reduction_t * reduction, open_node_t * open_node, constraint_t * constraints_matrix, double * bi,
+        const unsigned int num_constraints,
+        const unsigned int num_nodes,
+        const unsigned int cardinality_partitions)
+{
+    unsigned int i;
+    unsigned int pos;
+    int num_nz;
+    double constant;
+    constraint_t * constraint;
+
+#if defined ASSERT
+    assert(open_node->vect_mat_branching_contraint->num_nz <= (int) num_nodes);
+#endif
+
+    reduction->num_fixed = MEWCP_mark_fixed_nodes(open_node->list_blocked_nodes, num_nodes, cardinality_partitions, reduction->is_fixed);
+    reduction->num_free = 0;
+    for (i=0; i<num_nodes; ++i)
+    {
+        reduction->diagonal_position[i] = -1;
+        reduction->reduced_node[i] = -1;
+        if (reduction->is_fixed[i] == true)
+        {
+            reduction->reduced_node[i] = MEWCP_FIXED_NODE;
+        }
+        else if (open_node->list_blocked_nodes->bool_list[i] == false)
+        {
+            reduction->reduced_node[i] = reduction->num_free;
+            reduction->num_free += 1;
+        }
+    }
+
+    /* A constraint left empty would make the Schur matrix singular, W is the objective and stays.
+     * The solutions of the node satisfy the constraints, so an empty one has b equal to its constant
+     */
+    pos = 0;
+    reduction->num_kept = 0;
+    for (i=0; i<=num_constraints; ++i)
+    {
+        constraint = (i < num_constraints) ? &constraints_matrix[i] : open_node->vect_mat_branching_contraint;
+        num_nz = MEWCP_restrict_packed_matrix(reduction, constraint->index, constraint->weight, constraint->num_nz,
+                                              reduction->index_storage + pos, reduction->weight_storage + pos, &constant);
+        if (i == 0)
+        {
+            /* W has the opposite weights */
+            reduction->fixed_value = -constant;
+        }
+        if ((num_nz > 0) || (i == 0))
+        {
+            reduction->constraints[reduction->num_kept].index = reduction->index_storage + pos;
+            reduction->constraints[reduction->num_kept].weight = reduction->weight_storage + pos;
+            reduction->constraints[reduction->num_kept].num_nz = num_nz;
+            reduction->kept[reduction->num_kept] = i;
+            if (i > 0)
+            {
+                reduction->bi[reduction->num_kept-1] = bi[i-1] - constant;
+            }
+            reduction->num_kept += 1;
+            pos += num_nz;
+        }
+    }
+}
+
+bb_worker_t * MEWCP_allocate_bb_workers(bb_context_t * bb_context)
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_allocate_bb_workers *\n");
+#endif
+
+    unsigned int i;
+    bb_worker_t * bb_workers;
+
+    bb_workers = (bb_worker_t *) calloc(bb_context->bb_parameters->num_threads, sizeof(bb_worker_t));
+    if ( bb_workers == NULL)
+    {
+        printf("!!! ERROR allocation bb_workers! \n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i=0; i<bb_context->bb_parameters->num_threads; ++i)
+    {
+        bb_workers[i].id_worker = i;
+        bb_workers[i].bb_context = bb_context;
+        bb_workers[i].local_list = NULL;
+        bb_workers[i].dive_node = NULL;
+        bb_workers[i].workspace = &bb_context->bound_workspaces[i];
+        if (bb_context->bb_parameters->scheduler == MEWCP_SCHEDULER_STEALING)
+        {
+            bb_workers[i].local_list = MEWCP_allocate_list_branching();
+        }
     }
-#endif
 
-    /* All structures are updated */
+    return bb_workers;
 }
 
-double MEWCP_evaluate_list_nodes_solution(int * list_node_solution, matrix_weights_t * matrix_weights ,const unsigned int m)
+
+bound_workspace_t * MEWCP_allocate_bound_workspaces(const unsigned int num_workspaces, const unsigned int num_nodes, const unsigned int num_partitions,
+        constraint_t * constraints_matrix,
+        const unsigned int num_constraints,
+        cut_pool_t * cut_pool)
 {
-#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
-    printf("* MEWCP_evaluate_list_nodes_solution *\n");
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_allocate_bound_workspaces *\n");
 #endif
 
-    unsigned int i,j;
-
-    double z_tmp;
-    int pos_i;
-    int pos_j;
-
-    z_tmp = 0;
+    unsigned int i,t;
+    unsigned int max_cuts;
+    unsigned int cut_max_nz;
+    bound_workspace_t * bound_workspaces;
+    bound_workspace_t * workspace;
 
+    max_cuts = MEWCP_CUT_ROUNDS * MEWCP_CUTS_PER_ROUND;
+    cut_max_nz = (cut_pool != NULL) ? cut_pool->max_nz : MEWCP_CUT_MAX_NZ;
 
+    bound_workspaces = (bound_workspace_t *) calloc(num_workspaces, sizeof(bound_workspace_t));
+    if ( bound_workspaces == NULL)
+    {
+        printf("!!! ERROR allocation bound_workspaces! \n");
+        exit(EXIT_FAILURE);
+    }
 
-    for (i=0;i<m;++i)
+    for (i=0; i<num_workspaces; ++i)
     {
-        for(j=i; j<m;++j)
+        workspace = &bound_workspaces[i];
+        workspace->num_nodes = num_nodes;
+        workspace->num_partitions = num_partitions;
+
+        workspace->selected_node = (int *) calloc(num_partitions, sizeof(int));
+        workspace->value_k = (double *) calloc(num_partitions, sizeof(double));
+        workspace->newly_blocked = (bool *) calloc(num_partitions, sizeof(bool));
+        workspace->newly_free = (bool *) calloc(num_partitions, sizeof(bool));
+        workspace->pos_k = (unsigned int *) calloc(num_partitions, sizeof(unsigned int));
+        workspace->ithsolution = (int *) calloc(num_partitions, sizeof(int));
+        workspace->gray_partitions = (unsigned int *) calloc(num_partitions, sizeof(unsigned int));
+        workspace->focus_pointers = (unsigned int *) calloc(num_partitions +1, sizeof(unsigned int));
+        workspace->directions = (int *) calloc(num_partitions, sizeof(int));
+        workspace->dfs_partitions = (unsigned int *) calloc(num_partitions, sizeof(unsigned int));
+        workspace->dfs_links = (double *) calloc(num_nodes, sizeof(double));
+        workspace->dfs_remainders = (double *) calloc(num_nodes, sizeof(double));
+        workspace->dfs_best_edges = (double *) calloc(num_nodes*num_partitions, sizeof(double));
+        workspace->dfs_conflicts = (unsigned int *) calloc(num_nodes, sizeof(unsigned int));
+        workspace->to_be_blocked = (bool *) calloc(num_nodes, sizeof(bool));
+        workspace->candidate_node = (int *) calloc(num_nodes, sizeof(int));
+        workspace->candidate_part = (int *) calloc(num_nodes, sizeof(int));
+        workspace->candidate_mass_left = (double *) calloc(num_nodes, sizeof(double));
+        workspace->candidate_mass_right = (double *) calloc(num_nodes, sizeof(double));
+        workspace->candidate_gain_left = (double *) calloc(num_nodes, sizeof(double));
+        workspace->candidate_gain_right = (double *) calloc(num_nodes, sizeof(double));
+        workspace->candidate_reliable = (bool *) calloc(num_nodes, sizeof(bool));
+        workspace->partners = (int *) calloc(num_nodes*num_partitions, sizeof(int));
+        workspace->subgradient = (double *) calloc(num_nodes*num_partitions, sizeof(double));
+        workspace->best_multipliers = (double *) calloc(num_nodes*num_partitions, sizeof(double));
+        workspace->node_cuts = (sdp_cut_t *) calloc(max_cuts, sizeof(sdp_cut_t));
+        workspace->cut_constraints = (constraint_t *) calloc(max_cuts, sizeof(constraint_t));
+        workspace->cut_index_storage = (int *) calloc(max_cuts * cut_max_nz, sizeof(int));
+        workspace->cut_weight_storage = (double *) calloc(max_cuts * cut_max_nz, sizeof(double));
+        workspace->cut_rhs = (double *) calloc(max_cuts, sizeof(double));
+        workspace->cut_y = (double *) calloc(num_constraints + max_cuts, sizeof(double));
+        workspace->cut_family_matrix.index = (int *) calloc(cut_max_nz, sizeof(int));
+        workspace->cut_family_matrix.weight = (double *) calloc(cut_max_nz, sizeof(double));
+        workspace->buffer_X = (double *) calloc(num_nodes*(num_nodes+1)/2, sizeof(double));
+        workspace->cut_support = (sorted_neighbour_t *) calloc(num_nodes, sizeof(sorted_neighbour_t));
+        workspace->rounding_solutions = (int *) calloc(num_partitions*(num_partitions+1), sizeof(int));
+        workspace->rounding_values = (double *) calloc(num_partitions+1, sizeof(double));
+        workspace->alternative_values = (double *) calloc(num_nodes/num_partitions, sizeof(double));
+        if ( (workspace->selected_node == NULL) || (workspace->value_k == NULL) || (workspace->newly_blocked == NULL) ||
+                (workspace->newly_free == NULL) || (workspace->pos_k == NULL) || (workspace->ithsolution == NULL) ||
+                (workspace->gray_partitions == NULL) || (workspace->focus_pointers == NULL) || (workspace->directions == NULL) ||
+                (workspace->dfs_partitions == NULL) || (workspace->dfs_links == NULL) || (workspace->dfs_remainders == NULL) ||
+                (workspace->dfs_best_edges == NULL) || (workspace->dfs_conflicts == NULL) ||
+                (workspace->to_be_blocked == NULL) || (workspace->candidate_node == NULL) ||
+                (workspace->candidate_part == NULL) || (workspace->candidate_mass_left == NULL) ||
+                (workspace->candidate_mass_right == NULL) || (workspace->candidate_gain_left == NULL) ||
+                (workspace->candidate_gain_right == NULL) || (workspace->candidate_reliable == NULL) ||
+                (workspace->partners == NULL) ||
+                (workspace->subgradient == NULL) || (workspace->best_multipliers == NULL) ||
+                (workspace->node_cuts == NULL) || (workspace->cut_constraints == NULL) ||
+                (workspace->cut_index_storage == NULL) || (workspace->cut_weight_storage == NULL) ||
+                (workspace->cut_rhs == NULL) || (workspace->cut_y == NULL) ||
+                (workspace->cut_family_matrix.index == NULL) || (workspace->cut_family_matrix.weight == NULL) ||
+                (workspace->buffer_X == NULL) || (workspace->cut_support == NULL) ||
+                (workspace->rounding_solutions == NULL) || (workspace->rounding_values == NULL) ||
+                (workspace->alternative_values == NULL) )
         {
-            pos_i = list_node_solution[i];
-            pos_j = list_node_solution[j];
-            z_tmp += (double) matrix_weights->weight[pos_i][pos_j];
+            printf("!!! ERROR allocation bound_workspaces! \n");
+            exit(EXIT_FAILURE);
         }
-    }
-#if defined MEWCP_CONVERTER_DSDP_DEBUG
-    printf("Objective value of node_list: %.2lf\n",z_tmp);
-#endif
+        workspace->list_free_variables_partitions = MEWCP_allocate_list_free_varibles_partitions(num_partitions,num_nodes/num_partitions);
 
-    return z_tmp;
-}
+        workspace->sdp_reduction = NULL;
+#if defined REDUCED_SDP_ACTIVE
+        workspace->sdp_reduction = MEWCP_allocate_sdp_reduction(constraints_matrix,num_constraints,num_nodes);
+#endif
 
-int sort_compare (const void * a, const void * b)
-{
-    return ( *(int*)a - *(int*)b );
+        /* Each cut has its room for the matrix given to DSDP */
+        for (t=0; t<max_cuts; ++t)
+        {
+            workspace->cut_constraints[t].index = workspace->cut_index_storage + t*cut_max_nz;
+            workspace->cut_constraints[t].weight = workspace->cut_weight_storage + t*cut_max_nz;
+        }
 
-}
+        workspace->probe_node = MEWCP_allocate_open_node();
+        workspace->probe_node->list_blocked_nodes = MEWCP_allocate_list_blocked_nodes(num_nodes);
+        workspace->probe_node->list_nodes_solution = MEWCP_allocate_list_nodes_solution(num_partitions);
+        workspace->probe_node->combinatorial_cache = MEWCP_allocate_combinatorial_cache(num_nodes,num_partitions);
+        workspace->left_blocked_nodes = MEWCP_allocate_list_blocked_nodes(num_nodes);
+        workspace->right_blocked_nodes = MEWCP_allocate_list_blocked_nodes(num_nodes);
+    }
 
-void Take_Time(double * user_time, double * system_time)
-{
-    struct tms buff;
-    times(&buff);
-    *system_time = buff.tms_stime;
-    *user_time = buff.tms_utime;
-    *system_time /= 100;
-    *user_time /= 100;
-    
-    
+    return bound_workspaces;
 }
 
-double get_cpu_time(void)
+pseudo_costs_t * MEWCP_allocate_pseudo_costs(const unsigned int num_nodes)
 {
-	double user_time;
-	double  system_time;
-	struct tms buff;
-    
-    times(&buff);
-    system_time = buff.tms_stime;
-    user_time = buff.tms_utime;
-    system_time /= 100;
-    user_time /= 100;
-    
-    return user_time + system_time; 
-	
-}
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_allocate_pseudo_costs *\n");
+#endif
 
-open_node_t * MEWCP_allocate_open_node(void)
-{
-    open_node_t * open_node;
+    pseudo_costs_t * pseudo_costs;
 
-    open_node = (open_node_t *) calloc(1,sizeof (open_node_t));
-    if ( open_node == NULL)
+    pseudo_costs = (pseudo_costs_t *) calloc(1, sizeof(pseudo_costs_t));
+    if ( pseudo_costs == NULL)
     {
-        printf("!!! ERROR allocation open_node! \n");
+        printf("!!! ERROR allocation pseudo_costs! \n");
         exit(EXIT_FAILURE);
     }
 
-    open_node->id_node = -1;
-    open_node->DB = (double) MEWCP_MAX_DOUBLE;
-    open_node->PB = (double) MEWCP_MIN_DOUBLE;
-
-
-
-    open_node->list_nodes_solution = NULL;
-    open_node->diagX = NULL;
-    open_node->list_blocked_nodes = NULL;
-    open_node->vect_mat_branching_contraint = NULL;
-
-    return open_node;
+    pseudo_costs->num_nodes = num_nodes;
+    pseudo_costs->sum_left = (double *) calloc(num_nodes, sizeof(double));
+    pseudo_costs->sum_right = (double *) calloc(num_nodes, sizeof(double));
+    pseudo_costs->count_left = (unsigned int *) calloc(num_nodes, sizeof(unsigned int));
+    pseudo_costs->count_right = (unsigned int *) calloc(num_nodes, sizeof(unsigned int));
+    if ( pseudo_costs->sum_left == NULL || pseudo_costs->sum_right == NULL ||
+            pseudo_costs->count_left == NULL || pseudo_costs->count_right == NULL)
+    {
+        printf("!!! ERROR allocation pseudo_costs vectors! \n");
+        exit(EXIT_FAILURE);
+    }
+    pseudo_costs->sum_all = 0;
+    pseudo_costs->count_all = 0;
+    pthread_mutex_init(&pseudo_costs->mutex, NULL);
 
+    return pseudo_costs;
 }
 
-solution_bb_t * MEWCP_allocate_solution_bb(unsigned int num_partitions)
+bound_policy_t * MEWCP_allocate_bound_policy(void)
 {
 #if defined MEWCP_DSDP_DEBUG
-    printf("* MEWCP_allocate_solution_bb *\n");
+    printf("* MEWCP_allocate_bound_policy *\n");
 #endif
 
-    solution_bb_t * solution_bb;
+    bound_policy_t * bound_policy;
 
-    solution_bb = ( solution_bb_t *) calloc(1,sizeof(solution_bb_t) );
-    if ( solution_bb == NULL)
+    bound_policy = (bound_policy_t *) calloc(1, sizeof(bound_policy_t));
+    if ( bound_policy == NULL)
     {
-        printf("!!! ERROR allocation MEWCP_allocate_solution_bb! \n");
+        printf("!!! ERROR allocation bound_policy! \n");
         exit(EXIT_FAILURE);
     }
+    pthread_mutex_init(&bound_policy->mutex, NULL);
 
-    solution_bb->list_nodes_best_solution= MEWCP_allocate_list_nodes_solution(num_partitions);
-
-    return solution_bb;
-
+    return bound_policy;
 }
 
-
 list_blocked_nodes_t *  MEWCP_allocate_list_blocked_nodes(const unsigned int num_nodes )
 {
 #if defined MEWCP_CONVERTER_DSDP_VERBOSE1
@@ -1538,6 +3684,14 @@ list_branching_t * MEWCP_allocate_list_branching(void)
     list_branching->tail = NULL;
 
     list_branching->number_open_nodes = 0;
+    list_branching->number_working_nodes = 0;
+    list_branching->number_lazy_pruned_nodes = 0;
+    list_branching->stop = false;
+    list_branching->time_limit_reached = false;
+
+    pthread_mutex_init(&list_branching->mutex_list, NULL);
+    pthread_cond_init(&list_branching->cond_list, NULL);
+    pthread_mutex_init(&list_branching->mutex_best_primal, NULL);
 
     return list_branching;
 
@@ -1545,21 +3699,17 @@ list_branching_t * MEWCP_allocate_list_branching(void)
 }
 
 
-constraint_t * MEWCP_allocate_sdp_constraints_matrix(const unsigned int n, const unsigned int num_constraints )
+constraint_t * MEWCP_allocate_sdp_constraints_matrix(const unsigned int num_constraints )
 {
 #if defined MEWCP_CONVERTER_DSDP_VERBOSE1
     printf("* MEWCP_allocate_sdp_constraints_matrix *\n");
 #endif
 
-    unsigned int i;
-    unsigned int dim_vect_matrix;
-
-    dim_vect_matrix = n*(n+1)/2;
-
     constraint_t * sdp_constraints_matrix;
 
     /* I allocate the constraints matrix that is card(b) -1
-    * I don't consider the last matrix of branching constraints */
+    * I don't consider the last matrix of branching constraints.
+    * The storage comes later, when the nonzeros are counted */
     sdp_constraints_matrix = (constraint_t *) calloc(num_constraints , sizeof(constraint_t));
     if (sdp_constraints_matrix == NULL)
     {
@@ -1567,19 +3717,42 @@ constraint_t * MEWCP_allocate_sdp_constraints_matrix(const unsigned int n, const
         exit (EXIT_FAILURE);
     }
 
+    return sdp_constraints_matrix;
+}
+
+void MEWCP_allocate_sdp_constraints_storage(constraint_t * sdp_constraints_matrix, const unsigned int num_constraints )
+{
+#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
+    printf("* MEWCP_allocate_sdp_constraints_storage *\n");
+#endif
+
+    unsigned int i;
+    size_t total_nz;
+    int * index;
+    double * weight;
+
+    total_nz = 0;
     for (i=0; i < num_constraints ; ++i )
     {
-        sdp_constraints_matrix[i].index = (int *) calloc(dim_vect_matrix, sizeof(int));
-        sdp_constraints_matrix[i].weight = (double *) calloc(dim_vect_matrix, sizeof(double));
+        total_nz += sdp_constraints_matrix[i].num_nz;
+    }
 
-        if ( (sdp_constraints_matrix[i].index == NULL) || (sdp_constraints_matrix[i].weight == NULL))
-        {
-            printf("Allocation ERROR: sdp_constraints_matrix\n");
-            exit (EXIT_FAILURE);
-        }
+    /* The constraints are consecutive pieces of the same two arrays */
+    index = (int *) calloc(total_nz + 1, sizeof(int));
+    weight = (double *) calloc(total_nz + 1, sizeof(double));
+    if ( (index == NULL) || (weight == NULL))
+    {
+        printf("Allocation ERROR: sdp_constraints_matrix\n");
+        exit (EXIT_FAILURE);
     }
 
-    return sdp_constraints_matrix;
+    for (i=0; i < num_constraints ; ++i )
+    {
+        sdp_constraints_matrix[i].index = index;
+        sdp_constraints_matrix[i].weight = weight;
+        index += sdp_constraints_matrix[i].num_nz;
+        weight += sdp_constraints_matrix[i].num_nz;
+    }
 }
 
 
@@ -1608,6 +3781,25 @@ unsigned int MEWCP_convert_coords_ij_to_vector_matrix(const unsigned int i, cons
     return i*(i-1)/2 +j -1;
 }
 
+void MEWCP_convert_vector_matrix_to_coords_ij(const unsigned int pos, unsigned int * out_i, unsigned int * out_j)
+{
+    unsigned int i;
+
+    /* i is the largest one with i*(i-1)/2 <= pos, the square root may be a bit off */
+    i = (unsigned int) ((1.0 + sqrt(1.0 + 8.0 * pos)) / 2.0);
+    while (i*(i-1)/2 > pos)
+    {
+        --i;
+    }
+    while ((i+1)*i/2 <= pos)
+    {
+        ++i;
+    }
+
+    *out_i = i;
+    *out_j = pos - i*(i-1)/2 + 1;
+}
+
 constraint_t * MEWCP_allocate_vect_mat_branching_constraints(const unsigned int dim_matrix)
 {
     constraint_t * vect_mat_branching_contraints;
@@ -1721,6 +3913,13 @@ void MEWCP_clone_list_blocked_modes(list_blocked_nodes_t * list_to_be_cloned, li
 }
 
 
+void MEWCP_reset_list_blocked_nodes(list_blocked_nodes_t * list_blocked_nodes, const unsigned int num_nodes)
+{
+    memset(list_blocked_nodes->bool_list, 0, num_nodes * sizeof(bool));
+    list_blocked_nodes->num_blocked_nodes = 0;
+}
+
+
 void MEWCP_clone_list_nodes_solution( int * list_to_be_cloned,  int * list_cloned, const unsigned int num_nodes)
 {
     /* I copy the list */
@@ -1753,6 +3952,97 @@ void MEWCP_dump_diag_X(SDPCone * sdpcone, double * dst_diag_X, const unsigned in
 }
 
 
+void MEWCP_dump_node_diag_X(SDPCone * sdpcone, sdp_reduction_t * reduction, double * dst_diag_X, const unsigned int num_nodes)
+{
+    unsigned int i;
+    int dim_matrix;
+    double * sol_X;
+
+    if (reduction == NULL)
+    {
+        MEWCP_dump_diag_X(sdpcone, dst_diag_X, num_nodes);
+        return;
+    }
+
+    (void) SDPConeGetXArray(*sdpcone, 0, &sol_X, &dim_matrix);
+
+    /* The blocked nodes have X_ii = 0, the fixed ones X_ii = 1 */
+    for(i=0; i< num_nodes; ++i)
+    {
+        dst_diag_X[i] = 0.0;
+        if (reduction->reduced_node[i] >= 0)
+        {
+            dst_diag_X[i] = sol_X[MEWCP_convert_coords_ij_to_vector_matrix(reduction->reduced_node[i]+1,reduction->reduced_node[i]+1)];
+        }
+        else if (reduction->reduced_node[i] == MEWCP_FIXED_NODE)
+        {
+            dst_diag_X[i] = 1.0;
+        }
+    }
+}
+
+void MEWCP_dump_node_vect_y(DSDP * dsdp, sdp_reduction_t * reduction, double * dst_vect_y, const unsigned int num_constraints)
+{
+    unsigned int i;
+
+    if (reduction == NULL)
+    {
+        MEWCP_dump_vect_y(dsdp, dst_vect_y, num_constraints);
+        return;
+    }
+
+    DSDPGetY(*dsdp, reduction->vect_y, reduction->num_kept - 1);
+    for (i=1; i<reduction->num_kept; ++i)
+    {
+        dst_vect_y[reduction->kept[i]-1] = reduction->vect_y[i-1];
+    }
+}
+
+double * MEWCP_get_node_X(SDPCone * sdpcone, sdp_reduction_t * reduction, double * buffer)
+{
+    unsigned int i,j;
+    int dim_matrix;
+    double * sol_X;
+    int * reduced_node;
+    int reduced_i, reduced_j;
+
+    (void) SDPConeGetXArray(*sdpcone, 0, &sol_X, &dim_matrix);
+    if (reduction == NULL)
+    {
+        return sol_X;
+    }
+
+    /* A fixed node f has X_ff = 1 and X_fj = X_jj */
+    reduced_node = reduction->reduced_node;
+    memset(buffer, 0, reduction->num_nodes*(reduction->num_nodes+1)/2 * sizeof(double));
+    for (i=0; i<reduction->num_nodes; ++i)
+    {
+        if (reduced_node[i] == -1)
+        {
+            continue;
+        }
+        for (j=0; j<=i; ++j)
+        {
+            if (reduced_node[j] == -1)
+            {
+                continue;
+            }
+            reduced_i = (reduced_node[i] == MEWCP_FIXED_NODE) ? reduced_node[j] : reduced_node[i];
+            reduced_j = (reduced_node[j] == MEWCP_FIXED_NODE) ? reduced_i : reduced_node[j];
+            if (reduced_i == MEWCP_FIXED_NODE)
+            {
+                buffer[MEWCP_convert_coords_ij_to_vector_matrix(i+1,j+1)] = 1.0;
+            }
+            else
+            {
+                buffer[MEWCP_convert_coords_ij_to_vector_matrix(i+1,j+1)] =
+                    sol_X[MEWCP_convert_coords_ij_to_vector_matrix(reduced_i+1,reduced_j+1)];
+            }
+        }
+    }
+    return buffer;
+}
+
 void MEWCP_dump_vect_y(DSDP  * dsdp, double * dst_vect_y, const unsigned int num_constraints)
 {
 
@@ -1763,19 +4053,39 @@ void MEWCP_dump_vect_y(DSDP  * dsdp, double * dst_vect_y, const unsigned int num
 bool MEWCP_is_new_best_PB_and_update(open_node_t * open_node, list_branching_t * list_branching, const unsigned int num_partitions)
 {
     bool has_been_updated = false;
+    double best_primal;
+
+    best_primal = MEWCP_get_best_primal(list_branching);
+
+    /* The value is published first, most of the nodes don't improve the PB and don't lock */
+    while ( (open_node->PB - best_primal) >= MEWCP_EPSILON)
+    {
+        if (__atomic_compare_exchange(&list_branching->best_primal, &best_primal, &open_node->PB,
+                                      false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) == true)
+        {
+            has_been_updated = true;
+            break;
+        }
+    }
+
+    if (has_been_updated == false)
+    {
+        return false;
+    }
+
+    /* I copy the solution only if no better one has been published in the meantime */
+    pthread_mutex_lock(&list_branching->mutex_best_primal);
 
-    /* if PB improved */
-    if( (open_node->PB - list_branching->best_primal) >= MEWCP_EPSILON)
+    if (MEWCP_get_best_primal(list_branching) == open_node->PB)
     {
-        list_branching->best_primal = open_node->PB;
         list_branching->id_node_best_primal = open_node->id_node;
-        list_branching->serial_node_best_primal = open_node->serial_node;
+        __atomic_store_n(&list_branching->serial_node_best_primal, open_node->serial_node, __ATOMIC_RELAXED);
         list_branching->depth_node_best_primal = open_node->depth_level;
         MEWCP_clone_list_nodes_solution(open_node->list_nodes_solution,list_branching->list_nodes_best_solution, num_partitions);
-
-        /* Ok update completed */
-        has_been_updated = true;
     }
+
+    pthread_mutex_unlock(&list_branching->mutex_best_primal);
+
     return has_been_updated;
 }
 
@@ -1888,6 +4198,35 @@ void MEWCP_print_list_nodes_solution( int * list_nodes_solution, const unsigned
 }
 
 
+void MEWCP_print_bound_policy(bound_policy_t * bound_policy)
+{
+    unsigned int i,t;
+    bound_statistics_t total;
+    const char * bound_names[MEWCP_NUM_BOUND_TYPES] = {"Explicit","Combinatorial","SDP","Trivial","Lagrangian"};
+
+    printf("Bound policy:\n");
+    for (t=0; t<MEWCP_NUM_BOUND_TYPES; ++t)
+    {
+        memset(&total, 0, sizeof(bound_statistics_t));
+        for (i=0; i<MEWCP_POLICY_DEPTH_LEVELS; ++i)
+        {
+            total.num_calls += bound_policy->statistics[i][t].num_calls;
+            total.num_closed += bound_policy->statistics[i][t].num_closed;
+            total.time += bound_policy->statistics[i][t].time;
+        }
+        if (total.num_calls > 0)
+        {
+            printf("\t%s: calls: %u \t closed: %.1lf %% \t avg time: %.6lf s\n",bound_names[t],total.num_calls,
+                   100.0 * total.num_closed / total.num_calls, total.time / total.num_calls);
+        }
+    }
+    printf("\tCombinatorial rejected: %u (run anyway once every %d)\n",bound_policy->num_rejected[MEWCP_BOUND_COMBINATORIAL],MEWCP_POLICY_EXPLORATION_PERIOD);
+    printf("\tLagrangian rejected: %u\n",bound_policy->num_rejected[MEWCP_BOUND_LAGRANGIAN]);
+#if defined EXPLICIT_DFS_ACTIVE
+    printf("\tExplicit work limit: %.3e (default %.3e)\n",MEWCP_bound_policy_explicit_work(bound_policy,0),(double) MEWCP_MAX_EXPLICIT_WORK);
+#endif
+}
+
 void MEWCP_print_list_nodes_solution_cplex( int * list_nodes_solution, const unsigned int m)
 {
     unsigned int i;
@@ -1922,12 +4261,13 @@ void MEWCP_free_sdp_constraints_matrix(constraint_t * sdp_constraints_matrix, co
     printf("* MEWCP_free_sdp_constraints_matrix *\n");
 #endif
 
-    unsigned int i;
-    for(i=0;i<num_constraints;++i) /* matrix are num_contraints +1 but we do not consider the branching constraint matrix */
+    /* The first constraint starts the storage of all of them */
+    if (num_constraints > 0)
     {
-        free(sdp_constraints_matrix[i].index);
-        free(sdp_constraints_matrix[i].weight);
+        free(sdp_constraints_matrix[0].index);
+        free(sdp_constraints_matrix[0].weight);
     }
+    free(sdp_constraints_matrix);
 }
 void MEWCP_free_bi(double * bi)
 {
@@ -1988,6 +4328,9 @@ void MEWCP_free_open_node(open_node_t * open_node)
     MEWCP_free_diag_X(open_node->diagX);
     MEWCP_free_list_nodes_solution(open_node->list_nodes_solution);
     MEWCP_free_vect_y(open_node->vect_y);
+    MEWCP_free_pair_bounds(open_node->pair_bounds);
+    MEWCP_free_lagrangian_multipliers(open_node->lagrangian_multipliers);
+    MEWCP_free_combinatorial_cache(open_node->combinatorial_cache);
 
     free(open_node);
 }
@@ -2016,6 +4359,11 @@ void MEWCP_free_list_branching(list_branching_t * list_branching)
     }
 
     MEWCP_free_list_nodes_solution(list_branching->list_nodes_best_solution);
+
+    pthread_mutex_destroy(&list_branching->mutex_list);
+    pthread_cond_destroy(&list_branching->cond_list);
+    pthread_mutex_destroy(&list_branching->mutex_best_primal);
+
     /* As the list is empty I simply free the list structure */
     free(list_branching);
 
@@ -2030,3 +4378,134 @@ void MEWCP_free_solution_bb(solution_bb_t * solution_bb)
     free(solution_bb->list_nodes_best_solution);
     free(solution_bb );
 }
+
+void MEWCP_free_sdp_reduction(sdp_reduction_t * sdp_reduction)
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_free_sdp_reduction *\n");
+#endif
+
+    free(sdp_reduction->reduced_node);
+    free(sdp_reduction->kept);
+    free(sdp_reduction->constraints);
+    free(sdp_reduction->bi);
+    free(sdp_reduction->vect_y);
+    free(sdp_reduction->diagonal_position);
+    free(sdp_reduction->diagonal_touched);
+    free(sdp_reduction->is_fixed);
+    free(sdp_reduction->index_storage);
+    free(sdp_reduction->weight_storage);
+    free(sdp_reduction);
+}
+
+void MEWCP_free_pseudo_costs(pseudo_costs_t * pseudo_costs)
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_free_pseudo_costs *\n");
+#endif
+
+    free(pseudo_costs->sum_left);
+    free(pseudo_costs->sum_right);
+    free(pseudo_costs->count_left);
+    free(pseudo_costs->count_right);
+    pthread_mutex_destroy(&pseudo_costs->mutex);
+    free(pseudo_costs);
+}
+
+void MEWCP_free_bound_policy(bound_policy_t * bound_policy)
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_free_bound_policy *\n");
+#endif
+
+    pthread_mutex_destroy(&bound_policy->mutex);
+    free(bound_policy);
+}
+
+void MEWCP_free_bb_workers(bb_worker_t * bb_workers, const unsigned int num_threads)
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_free_bb_workers *\n");
+#endif
+
+    unsigned int i;
+
+    for (i=0; i<num_threads; ++i)
+    {
+        if (bb_workers[i].local_list != NULL)
+        {
+            MEWCP_free_list_branching(bb_workers[i].local_list);
+        }
+    }
+    free(bb_workers);
+}
+
+
+void MEWCP_free_bound_workspaces(bound_workspace_t * bound_workspaces, const unsigned int num_workspaces)
+{
+#if defined MEWCP_DSDP_DEBUG
+    printf("* MEWCP_free_bound_workspaces *\n");
+#endif
+
+    unsigned int i;
+    bound_workspace_t * workspace;
+
+    for (i=0; i<num_workspaces; ++i)
+    {
+        workspace = &bound_workspaces[i];
+        free(workspace->selected_node);
+        free(workspace->value_k);
+        free(workspace->newly_blocked);
+        free(workspace->newly_free);
+        free(workspace->pos_k);
+        free(workspace->ithsolution);
+        free(workspace->gray_partitions);
+        free(workspace->focus_pointers);
+        free(workspace->directions);
+        free(workspace->dfs_partitions);
+        free(workspace->dfs_links);
+        free(workspace->dfs_remainders);
+        free(workspace->dfs_best_edges);
+        free(workspace->dfs_conflicts);
+        free(workspace->to_be_blocked);
+        free(workspace->candidate_node);
+        free(workspace->candidate_part);
+        free(workspace->candidate_mass_left);
+        free(workspace->candidate_mass_right);
+        free(workspace->candidate_gain_left);
+        free(workspace->candidate_gain_right);
+        free(workspace->candidate_reliable);
+        free(workspace->partners);
+        free(workspace->subgradient);
+        free(workspace->best_multipliers);
+        free(workspace->node_cuts);
+        free(workspace->cut_constraints);
+        free(workspace->cut_index_storage);
+        free(workspace->cut_weight_storage);
+        free(workspace->cut_rhs);
+        free(workspace->cut_y);
+        free(workspace->cut_family_matrix.index);
+        free(workspace->cut_family_matrix.weight);
+        if (workspace->sdp_reduction != NULL)
+        {
+            MEWCP_free_sdp_reduction(workspace->sdp_reduction);
+        }
+        free(workspace->buffer_X);
+        free(workspace->cut_support);
+        free(workspace->rounding_solutions);
+        free(workspace->rounding_values);
+        free(workspace->alternative_values);
+        MEWCP_free_list_free_varibles_partitions(workspace->list_free_variables_partitions,workspace->num_partitions);
+
+        MEWCP_free_list_blocked_nodes(workspace->probe_node->list_blocked_nodes);
+        free(workspace->probe_node->list_blocked_nodes);
+        MEWCP_free_list_nodes_solution(workspace->probe_node->list_nodes_solution);
+        MEWCP_free_combinatorial_cache(workspace->probe_node->combinatorial_cache);
+        free(workspace->probe_node);
+        MEWCP_free_list_blocked_nodes(workspace->left_blocked_nodes);
+        MEWCP_free_list_blocked_nodes(workspace->right_blocked_nodes);
+        free(workspace->left_blocked_nodes);
+        free(workspace->right_blocked_nodes);
+    }
+    free(bound_workspaces);
+}
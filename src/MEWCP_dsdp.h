@@ -9,6 +9,8 @@
  *
  ****************************************************************************/
 
+#include <pthread.h>
+
 #include "dsdp/dsdp5.h"
 #include "MEWCP_tabu_definitions.h"
 
@@ -22,6 +24,55 @@
 /* Activation of the combinatorial preprocessing at the root node */
 #define  PREPROCESSING_ACTIVE
 
+/* The combinatorial probing of the root is repeated at the B&B nodes
+ * when the best primal has improved */
+#define NODE_FIXING_ACTIVE
+
+/* The combinatorial bound of a son is run or skipped according to
+ * its measured cost and prune rate against the SDP bound */
+#define BOUND_POLICY_ACTIVE
+
+/* Each node is solved first with a coarse gap tolerance, the tight one
+ * is used only if the bound is near the best primal */
+#define ADAPTIVE_GAP_ACTIVE
+
+/* Before the other bounds a son is bounded by the sum of the pair bounds
+ * of the partitions, inherited from the father and updated incrementally */
+#define TRIVIAL_BOUND_ACTIVE
+
+/* For each node and partition the nodes of the partition are sorted once by
+ * the edge plus the vertex share, the bounds take the first free one */
+#define SORTED_NEIGHBOURS_ACTIVE
+
+/* The root preprocessing also probes pairs of nodes of different partitions, the pairs
+ * that can't be in a better solution are excluded by the bounds and the enumeration */
+#define CONFLICTS_ACTIVE
+
+/* After the combinatorial bound a son is bounded by its Lagrangian relaxation: the multipliers
+ * on the agreement of the edges chosen by the two partitions start from the father's ones
+ * and are tightened by subgradient steps */
+#define LAGRANGIAN_BOUND_ACTIVE
+
+/* The explicit enumeration fixes the partitions depth first and prunes against the best primal,
+ * a node is enumerated if its estimated work is below MEWCP_MAX_EXPLICIT_WORK */
+#define EXPLICIT_DFS_ACTIVE
+
+/* The rounding of the SDP solution is improved by exchanging the node of one partition at a time */
+//#define LOCAL_SEARCH_ACTIVE
+
+/* The SDP bound of a node near the best primal is tightened by cutting planes: the violated
+ * constraints of the families left out of the problem and the violated triangle inequalities
+ * are added, from a pool shared by the workers, and the node is solved again */
+#define CUTTING_PLANES_ACTIVE
+
+/* A node with enough blocked nodes is solved on the free ones only: their rows are dropped from
+ * all the matrices and the SDP block is smaller */
+#define REDUCED_SDP_ACTIVE
+
+/* In a reduced node the partitions with one free node are fixed: their node leaves the SDP, its
+ * edges towards the free nodes go on their diagonal and the rest is a constant. Needs REDUCED_SDP_ACTIVE */
+#define CONTRACTED_SDP_ACTIVE
+
 
 
 /* LOG DEFINITIONS */
@@ -65,10 +116,14 @@
 /* DSDP PARAMETERS */
 
 #define MEWCP_GAP_TOLERANCE 0.0001
+#define MEWCP_GAP_TOLERANCE_LOOSE 0.01
+#define MEWCP_ADAPTIVE_GAP_MARGIN 0.01	/* relative to the best primal: nearer than this the node is solved tight */
 #define MEWCP_POTENTIAL_PARAMETER 5
 #define MEWCP_REUSE_MATRIX 2
 #define MEWCP_SET_PNORM_TOLERANCE 1.0
 #define MEWCP_ALPHA 1.0
+#define MEWCP_REDUCED_SDP_RATIO 0.9	/* the node is reduced if its free nodes are at most this part of the nodes */
+#define MEWCP_FIXED_NODE -2		/* reduced_node of the node of a fixed partition */
 
 //#define MEWCP_R_ZERO 1.0
 
@@ -76,6 +131,87 @@
 #define MEWCP_MIN_DOUBLE -10E7 /* Is the (double) -infinity */
 #define MEWCP_MAX_DOUBLE 10E12
 #define MEWCP_MAX_EXPLICIT_SOLUTIONS 500000
+#define MEWCP_MAX_EXPLICIT_WORK 50000000	/* elementary steps of the depth first enumeration without pruning */
+#define MEWCP_EXPLICIT_TASKS_PER_THREAD 8	/* the root enumeration is split in at least these tasks per thread */
+
+/* B&B PARAMETERS */
+#define MEWCP_DEFAULT_NUM_THREADS 1
+#define MEWCP_MAX_NUM_THREADS 256
+
+/* How the open nodes are shared among the B&B workers */
+#define MEWCP_SCHEDULER_SHARED 0	/* one best-first list for all the workers */
+#define MEWCP_SCHEDULER_STEALING 1	/* each worker dives on its own list and steals when idle */
+
+/* How the next open node is selected from the shared list */
+#define MEWCP_NODE_SELECTION_BEST_FIRST 0	/* max DB */
+#define MEWCP_NODE_SELECTION_DEPTH_FIRST 1	/* deepest node, ties by max DB */
+#define MEWCP_NODE_SELECTION_BEST_ESTIMATE 2	/* max estimate of the best solution in the subtree */
+#define MEWCP_NODE_SELECTION_HYBRID 3		/* depth first until both sons are closed, then best first */
+
+/* Bound types of the bound-selection policy */
+#define MEWCP_BOUND_EXPLICIT 0
+#define MEWCP_BOUND_COMBINATORIAL 1
+#define MEWCP_BOUND_SDP 2
+#define MEWCP_BOUND_TRIVIAL 3
+#define MEWCP_BOUND_LAGRANGIAN 4
+#define MEWCP_NUM_BOUND_TYPES 5
+
+#define MEWCP_POLICY_DEPTH_LEVELS 32		/* the deeper nodes share the last level */
+#define MEWCP_POLICY_MIN_SAMPLES 10		/* with less calls at a level the statistics of all the levels are used */
+#define MEWCP_POLICY_EXPLORATION_PERIOD 20	/* a skipped combinatorial bound is run anyway once every period */
+#define MEWCP_POLICY_EXPLICIT_RANGE 16		/* the learnt explicit work limit stays within this factor of MEWCP_MAX_EXPLICIT_WORK */
+
+/* Probes of the root preprocessing taken at once by a worker */
+#define MEWCP_PREPROCESSING_CHUNK 8
+
+/* Free nodes with the lowest probe DB whose pairs are probed by a pass of the preprocessing */
+#define MEWCP_CONFLICT_CANDIDATES 16
+
+/* Subgradient steps of the Lagrangian bound: at most ITERATIONS, the step factor starts
+ * from STEP and is halved after HALVING steps without a better bound */
+#define MEWCP_LAGRANGIAN_ITERATIONS 40
+#define MEWCP_LAGRANGIAN_STEP 1.0
+#define MEWCP_LAGRANGIAN_HALVING 4
+
+/* Node fixing is tried only on the nodes up to this depth */
+#define MEWCP_NODE_FIXING_MAX_DEPTH 8
+
+/* Cuts separated from the X of a node */
+#define MEWCP_CUT_NONNEGATIVE 1		/* X_ij >= 0 */
+#define MEWCP_CUT_DIAGONAL 2		/* X_ij <= X_ii */
+#define MEWCP_CUT_PAIR 3		/* X_ii + X_jj - X_ij <= 1 */
+#define MEWCP_CUT_TRIANGLE 4		/* X_ik + X_jk - X_ij <= X_kk */
+#define MEWCP_CUT_MAX_NZ 4		/* nonzeros of the packed matrix of a triangle inequality */
+
+/* Equalities of the disabled families, as written by converter_dsdp.c */
+#define MEWCP_CUT_CARDINALITY 5		/* sum of the X_ii = m */
+#define MEWCP_CUT_IMPROVED_MC_B 6	/* sum of the X_vi of the nodes i of the partition u = X_vv, v not in u */
+#define MEWCP_CUT_IMPROVED_MC_C 7	/* sum of the X_ij, i != j, in the partition u = 0 */
+#define MEWCP_CUT_4C3_A 8		/* sum of the X_ij of the nodes j of the other partitions = (m-1) X_ii */
+#define MEWCP_CUT_4C3_B 9		/* m X_ii + sum of the X_jj, j != i, - sum of the X_ij of the other partitions = m */
+#define MEWCP_CUT_TYPES 10
+
+#define MEWCP_CUT_ROUNDS 3		/* solves with cuts of a node at most */
+#define MEWCP_CUTS_PER_ROUND 32		/* most violated cuts added by a round */
+#define MEWCP_CUT_VIOLATION 1E-3	/* a cut less violated than this is satisfied */
+#define MEWCP_CUT_MARGIN 0.05		/* relative to the best primal: farther than this the node is not cut, the root always is */
+#define MEWCP_CUT_MIN_IMPROVEMENT 1E-4	/* relative DB improvement of a round to go on with the next one */
+#define MEWCP_CUT_TRIANGLE_NODES 64	/* the triangles are separated among the nodes with the largest X_ii */
+#define MEWCP_CUT_POOL_SIZE 1024
+#define MEWCP_CUT_MAX_AGE 32		/* a pool cut not violated by this number of checks in a row is dropped */
+
+/* How the partition and the split node are chosen */
+#define MEWCP_BRANCHING_PERFECT_EQUI 0	/* split nearest to half of the fractional mass */
+#define MEWCP_BRANCHING_EQUI 1
+#define MEWCP_BRANCHING_MAX_FRACTIONAL 2
+#define MEWCP_BRANCHING_PSEUDO_COST 3	/* reliability branching on the pseudo-costs of the splits */
+
+/* A split is reliable when both its sons have been observed at least this number of times */
+#define MEWCP_RELIABILITY_THRESHOLD 4
+/* Max number of unreliable splits evaluated with the combinatorial bound at each node */
+#define MEWCP_STRONG_BRANCHING_CANDIDATES 8
+/* Min DB degradation in the product score, so a null side doesn't hide the other one */
+#define MEWCP_PSEUDO_COST_MIN_GAIN 1E-6
 
 /*
  * DSDP Data structures 
@@ -104,9 +240,25 @@ typedef struct solution_bb_s
     double timestamp_system_time_root;
     double time_DB_root_combinatorial;  //time for combinatorial at root node 
     double time_DB_root_semidefinite;   //time for semidefinite at root node
+    double wall_time;   /* real time of the B&B, with more threads it is less than the cpu time */
+    unsigned int number_lazy_pruned_nodes;  /* sons closed before their bound, SDP solves saved */
+    unsigned int number_sdp_iterations;     /* DSDP iterations of all the bounds */
+    unsigned int number_sdp_tightened;      /* bounds that needed the tight tolerance after the coarse one */
+    unsigned int number_fixed_nodes;        /* nodes blocked by the probing at the B&B nodes */
 }
 solution_bb_t;
 
+/* Parameters of the branch and bound given from command line */
+typedef struct bb_parameters_s
+{
+    unsigned int num_threads;	/* number of B&B workers */
+    unsigned int scheduler;		/* MEWCP_SCHEDULER_SHARED or MEWCP_SCHEDULER_STEALING */
+    unsigned int node_selection;	/* MEWCP_NODE_SELECTION_xxx, used by the shared scheduler */
+    unsigned int branching_rule;	/* MEWCP_BRANCHING_xxx */
+    bool lazy_bounding;			/* the sons are bounded when popped, not when generated */
+}
+bb_parameters_t;
+
 #define NUM_BLOCKS 1
 
 
@@ -127,6 +279,40 @@ typedef struct list_blocked_node_s
 list_blocked_nodes_t;
 
 
+/* Entry of the sorted neighbour lists, only used to build them */
+typedef struct sorted_neighbour_s
+{
+    double key;		/* w_ij + w_jj/(m-1) */
+    int node;
+}
+sorted_neighbour_t;
+
+/* Best edges of the combinatorial bound, valid for the blocked list it was computed on.
+ * The sons share the cache of the father, a node copies it only when it computes its own bound
+ */
+typedef struct combinatorial_cache_s
+{
+    unsigned int num_nodes;
+    unsigned int num_partitions;
+    unsigned int num_references;	/* nodes sharing it, atomic. It is written only with one reference */
+    bool * blocked;		/* blocked list of the last computation, all true if none */
+    int * selected_edges;	/* [i*num_partitions + t]: best free j of the partition t for the node i, -1 if none */
+    double * node_values;	/* w_ii plus the best edges (with the shares of the vertex weights) of the node i */
+}
+combinatorial_cache_t;
+
+/* Multipliers of the Lagrangian bound, shared by the sons like the combinatorial cache */
+typedef struct lagrangian_multipliers_s
+{
+    unsigned int num_nodes;
+    unsigned int num_partitions;
+    unsigned int num_references;	/* nodes sharing them, atomic. They are written only with one reference */
+    double * values;		/* [i*num_partitions + t] */
+}
+lagrangian_multipliers_t;
+
+
+
 typedef struct open_node_s
 {
 
@@ -139,6 +325,7 @@ typedef struct open_node_s
     
     double PB;
     double DB;
+    double estimate;	/* Estimate of the best solution in the subtree, DB corrected by the fractionality of diagX */
     unsigned int depth_level;  /* Is the level in the tree */
     list_blocked_nodes_t * list_blocked_nodes;
     constraint_t * vect_mat_branching_contraint;
@@ -149,9 +336,235 @@ typedef struct open_node_s
      */
     double * diagX;
     int * list_nodes_solution;
+
+    /* Branching that generated the node, to update the pseudo-costs once it is bounded */
+    int branch_split_node;	/* the left son keeps the nodes of the partition up to it, -1 for the root */
+    bool branch_is_left;
+    double branch_mass;		/* fractional mass of the father's diagX removed in this son */
+    double father_DB;
+
+    /* Lazy bounding: until it is popped the node has the DB of the father */
+    bool is_bounded;
+    bool active_combinatorial_bound;	/* decided by the father as for the sons bounded at once */
+
+    /* DSDP iterations of the SDP bound, and if the coarse solution has been tightened */
+    unsigned int sdp_iterations;
+    bool sdp_tightened;
+
+    /* Best primal of the last combinatorial fixing on the path from the root */
+    double fixing_best_primal;
+
+    /* Pair bounds of the partitions for the trivial bound, NULL if not computed */
+    double * pair_bounds;
+
+    /* Combinatorial bound of the node (or of its father), NULL if not computed */
+    combinatorial_cache_t * combinatorial_cache;
+
+    /* Multipliers of the Lagrangian bound (or of its father), num_nodes x num_partitions, NULL if not computed */
+    lagrangian_multipliers_t * lagrangian_multipliers;
 }
 open_node_t;
 
+/* Buffers of the combinatorial bound, of the explicit enumeration and of the probes,
+ * allocated once per solve for each worker: the bounds allocate nothing */
+typedef struct bound_workspace_s
+{
+    unsigned int num_nodes;
+    unsigned int num_partitions;
+
+    /* Combinatorial bound, num_partitions each */
+    int * selected_node;
+    double * value_k;
+    bool * newly_blocked;
+    bool * newly_free;
+
+    /* Explicit enumeration, focus_pointers has num_partitions+1 elements */
+    unsigned int * pos_k;
+    int * ithsolution;
+    unsigned int * gray_partitions;
+    unsigned int * focus_pointers;
+    int * directions;
+
+    /* Depth first enumeration: order of the partitions, and for each free node its edges towards the
+     * fixed nodes, the sum of its best edges towards the other partitions to fix and its conflicts */
+    unsigned int * dfs_partitions;
+    double * dfs_links;
+    double * dfs_remainders;
+    double * dfs_best_edges;	/* num_nodes x num_partitions */
+    unsigned int * dfs_conflicts;
+    struct element_free_variables_partitions_s * list_free_variables_partitions;
+
+    /* Probes of the preprocessing, of the node fixing and of the strong branching */
+    open_node_t * probe_node;	/* only blocked list, solution and combinatorial cache */
+    bool * to_be_blocked;
+    list_blocked_nodes_t * left_blocked_nodes;
+    list_blocked_nodes_t * right_blocked_nodes;
+
+    /* Candidate splits of the pseudo-cost branching, num_nodes each */
+    int * candidate_node;
+    int * candidate_part;
+    double * candidate_mass_left;
+    double * candidate_mass_right;
+    double * candidate_gain_left;
+    double * candidate_gain_right;
+    bool * candidate_reliable;
+
+    /* Lagrangian bound, num_nodes x num_partitions each */
+    int * partners;
+    double * subgradient;
+    double * best_multipliers;
+
+    /* Problem of the node restricted to its free nodes, sized on the full problem and filled at each node.
+     * NULL without REDUCED_SDP_ACTIVE */
+    struct sdp_reduction_s * sdp_reduction;
+
+    /* Cutting planes of the SDP bound: the cuts of all the rounds (MEWCP_CUT_ROUNDS x MEWCP_CUTS_PER_ROUND)
+     * with their matrices (cut_pool->max_nz elements each) and rhs for DSDP, the y of the last round,
+     * the matrix of a family cut being evaluated, the X of all the nodes for a reduced problem and the nodes of the triangles */
+    struct sdp_cut_s * node_cuts;
+    constraint_t * cut_constraints;
+    int * cut_index_storage;
+    double * cut_weight_storage;
+    double * cut_rhs;
+    double * cut_y;		/* num_constraints and the cuts */
+    constraint_t cut_family_matrix;
+    double * buffer_X;		/* num_nodes(num_nodes+1)/2 */
+    sorted_neighbour_t * cut_support;	/* num_nodes */
+
+    /* Rounding of the SDP bound: its candidates for the batch evaluation, partition major
+     * (num_partitions x (num_partitions+1)), their values and the values of the local search (cardinality) */
+    int * rounding_solutions;
+    double * rounding_values;
+    double * alternative_values;
+}
+bound_workspace_t;
+
+/* Root preprocessing shared by the workers */
+typedef struct preprocessing_context_s
+{
+    matrix_weights_t * matrix_weights;
+    unsigned int num_partitions;
+    unsigned int cardinality_partitions;
+    list_blocked_nodes_t * list_blocked_nodes;	/* blocked by the previous passes, read only during a pass */
+    bool pair_pass;		/* the probes are the rows of the candidates instead of the nodes */
+    unsigned int num_probes;
+    unsigned int next_probe;	/* first probe not taken yet, atomic */
+    double best_primal;		/* atomic, updated by compare and exchange */
+    double * vect_dual;		/* DB of each probe */
+    int * candidates;		/* nodes of the rows of a pair pass */
+    bool * new_conflicts;	/* MEWCP_CONFLICT_CANDIDATES x n, the row r of candidates[r] is written only by its probe */
+}
+preprocessing_context_t;
+
+typedef struct preprocessing_worker_s
+{
+    unsigned int id_worker;
+    pthread_t thread;
+    preprocessing_context_t * preprocessing_context;
+    bound_workspace_t * workspace;	/* its probe node keeps the cache of the last probe */
+}
+preprocessing_worker_t;
+
+/* Pseudo-costs of the splits, indexed by the split node: average DB degradation
+ * of the left and right son per unit of fractional mass removed. Shared by the workers.
+ */
+typedef struct pseudo_costs_s
+{
+    unsigned int num_nodes;
+    double * sum_left;
+    double * sum_right;
+    unsigned int * count_left;
+    unsigned int * count_right;
+    double sum_all;		/* all the observations, used for the splits never seen */
+    unsigned int count_all;
+    pthread_mutex_t mutex;
+}
+pseudo_costs_t;
+
+
+/* Cost and effect of a bound type at a depth level */
+typedef struct bound_statistics_s
+{
+    unsigned int num_calls;
+    unsigned int num_closed;	/* nodes closed by the bound */
+    double time;		/* cpu time of the calls */
+}
+bound_statistics_t;
+
+/* Online statistics of the bounds, shared by the workers */
+typedef struct bound_policy_s
+{
+    bound_statistics_t statistics[MEWCP_POLICY_DEPTH_LEVELS][MEWCP_NUM_BOUND_TYPES];
+    unsigned int num_rejected[MEWCP_NUM_BOUND_TYPES];
+    double explicit_work;	/* estimated work of the explicit calls, with their time it gives the cost of a unit */
+    pthread_mutex_t mutex;
+}
+bound_policy_t;
+
+/* A cut on X: A.X <= rhs or A.X = rhs. The triangle inequalities keep their packed matrix,
+ * the one of a family cut is written from its nodes when needed */
+typedef struct sdp_cut_s
+{
+    int type;			/* MEWCP_CUT_xxx */
+    int nodes[3];		/* i, j, k of the inequality; the node (v) and the partition (u) of a family cut */
+    int index[MEWCP_CUT_MAX_NZ];
+    double weight[MEWCP_CUT_MAX_NZ];
+    int num_nz;
+    double rhs;
+    bool is_inequality;
+    double violation;		/* by the X it has been separated from */
+    unsigned int age;		/* checks in a row without being violated */
+}
+sdp_cut_t;
+
+/* Cuts found by the workers, with the disabled families to separate */
+typedef struct cut_pool_s
+{
+    unsigned int num_nodes;
+    unsigned int num_partitions;
+    bool is_family_separated[MEWCP_CUT_TYPES];	/* by the type of its cuts */
+    unsigned int num_candidates;	/* constraints of the separated families */
+    unsigned int max_nz;		/* nonzeros of the largest cut matrix */
+    bool * is_diagonal;		/* positions of the packed matrix on the diagonal */
+
+    sdp_cut_t * cuts;
+    unsigned int num_cuts;
+
+    unsigned int number_rounds;	/* solves with cuts */
+    unsigned int number_cuts;	/* cuts added to the solves */
+    unsigned int number_improved;	/* solves that tightened the DB */
+    unsigned int number_closed;	/* nodes closed by the cuts */
+    pthread_mutex_t mutex;
+}
+cut_pool_t;
+
+
+/* Problem of a node restricted to its free nodes. A blocked node has X_vv = 0 and X is PSD, so its
+ * row of X is 0: its elements are dropped from all the matrices and the constraints left empty
+ * (the branching one at least) are dropped too.
+ * The node f of a fixed partition is contracted: X_ff = 1 and X_fj = X_jj, so its elements towards
+ * the free nodes are added on their diagonal and the ones among fixed nodes go in b (in fixed_value for W)
+ */
+typedef struct sdp_reduction_s
+{
+    unsigned int num_nodes;
+    unsigned int num_free;
+    unsigned int num_fixed;
+    int * reduced_node;		/* position of each node among the free ones, -1 if blocked, MEWCP_FIXED_NODE if fixed */
+    double fixed_value;		/* W.X of the fixed nodes, the SDP value of the node is -pobj + fixed_value */
+    unsigned int num_kept;	/* W and the constraints not empty */
+    unsigned int * kept;	/* their index in the problem of the node, the branching one is num_constraints */
+    constraint_t * constraints;	/* restricted, W first */
+    double * bi;		/* of the kept constraints after W */
+    double * vect_y;		/* buffer for the y of the reduced problem */
+    int * diagonal_position;	/* where the diagonal element of each free node is summed while restricting, -1 if none */
+    int * diagonal_touched;
+    bool * is_fixed;
+    int * index_storage;	/* all the nonzeros of the constraints and num_nodes for the branching one */
+    double * weight_storage;
+}
+sdp_reduction_t;
+
 
 typedef struct branching_open_node_s
 {
@@ -167,7 +580,7 @@ typedef struct list_branching_s
 {
     branching_open_node_t * branching_open_node_t;
 
-    double best_primal;
+    double best_primal;		/* atomic, updated by compare and exchange */
     unsigned int number_open_nodes;
     unsigned int number_explored_nodes;
     unsigned int id_node_best_primal;
@@ -175,16 +588,74 @@ typedef struct list_branching_s
     unsigned int depth_node_best_primal;
     unsigned int max_exploration_level;
     unsigned int current_serial_number;
+    unsigned int number_lazy_pruned_nodes;
+
+    /* DSDP statistics, updated atomically by the workers */
+    unsigned int number_sdp_tightened;
+    unsigned int number_sdp_iterations;
+    unsigned int number_fixed_nodes;
     
     int * list_nodes_best_solution;
 
     branching_open_node_t * head;
     branching_open_node_t * tail;
 
+    /* The list is shared among the B&B workers */
+    pthread_mutex_t mutex_list;         /* protects the open nodes and their counters */
+    pthread_cond_t cond_list;           /* an idle worker waits here for new open nodes */
+    pthread_mutex_t mutex_best_primal;  /* protects the copy of the best solution and of its node */
+    unsigned int number_working_nodes;  /* nodes popped by a worker and not yet branched */
+    bool stop;                          /* tree explored or time limit reached */
+    bool time_limit_reached;
+
+    /* Work stealing: the open nodes are in the lists of the workers */
+    int number_pending_nodes;           /* open nodes in all the lists plus nodes being processed */
+    unsigned int number_idle_workers;   /* workers waiting for a node to steal */
+
 }
 list_branching_t;
 
 
+/* Everything a B&B worker needs to process an open node */
+struct bb_worker_s;
+
+typedef struct bb_context_s
+{
+    list_branching_t * list_branching;
+    bb_parameters_t * bb_parameters;
+    struct bb_worker_s * bb_workers;   /* a thief looks into the lists of the others */
+    pseudo_costs_t * pseudo_costs;     /* NULL if the branching rule doesn't use them */
+    bound_policy_t * bound_policy;     /* NULL if BOUND_POLICY_ACTIVE is not defined */
+    bound_workspace_t * bound_workspaces;	/* one per worker */
+    cut_pool_t * cut_pool;             /* NULL if CUTTING_PLANES_ACTIVE is not defined */
+
+    constraint_t * constraints_matrix;
+    matrix_weights_t * matrix_weigths;
+    double * bi;
+    unsigned int num_constraints;
+    unsigned int dim_matrix;
+    unsigned int num_nodes;
+    unsigned int num_partitions;
+    unsigned int cardinality_partitions;
+
+    double time_limit;
+    double time_start_cpu;   /* cpu time at the start of the B&B */
+    double time_start_wall;  /* real time at the start of the B&B */
+}
+bb_context_t;
+
+typedef struct bb_worker_s
+{
+    unsigned int id_worker;
+    pthread_t thread;
+    bb_context_t * bb_context;
+    list_branching_t * local_list;  /* work stealing: the owner pops from the head, the thieves from the tail */
+    open_node_t * dive_node;        /* hybrid selection: the son the worker goes on with, still counted as working */
+    bound_workspace_t * workspace;  /* one of bb_context->bound_workspaces */
+}
+bb_worker_t;
+
+
 
 /*
  * BRANCHING FUNCTIONS
@@ -194,6 +665,27 @@ list_branching_t;
 bool MEWCP_generate_equi_branch_node(double * diag_X, const unsigned int n, const unsigned int m,  int * out_num_part,  int * out_id_node);
 bool MEWCP_generate_perfect_equi_branch(double * diag_X, const unsigned int n, const unsigned int m,  int * out_num_part,  int * out_id_node);
 bool MEWCP_generate_max_fractional_branch(double * diag_X, const unsigned int n, const unsigned int m,  int * out_num_part,  int * out_id_node);
+
+/* Product score of the pseudo-costs, the unreliable splits are first evaluated with the combinatorial bound */
+bool MEWCP_generate_pseudo_cost_branch(open_node_t * open_node, pseudo_costs_t * pseudo_costs, matrix_weights_t * matrix_weights,
+                                       bound_workspace_t * workspace,
+                                       const unsigned int n, const unsigned int m,  int * out_num_part,  int * out_id_node);
+
+/* Degradation of the combinatorial bound of the two sons of a split, the result is added to the pseudo-costs */
+void MEWCP_strong_branching_combinatorial(open_node_t * open_node, pseudo_costs_t * pseudo_costs, matrix_weights_t * matrix_weights,
+        bound_workspace_t * workspace, const double father_DB_comb, const double mass_left, const double mass_right,
+        const int num_part, const int split_node, const unsigned int n, const unsigned int m,
+        double * out_gain_left, double * out_gain_right);
+
+/* Combinatorial DB of a node with the given blocked nodes, start_cache (may be NULL) is the one of a near node */
+double MEWCP_combinatorial_bound_blocked_nodes(list_blocked_nodes_t * list_blocked_nodes, const combinatorial_cache_t * start_cache,
+        bound_workspace_t * workspace, matrix_weights_t * matrix_weights, const unsigned int n, const unsigned int m);
+
+/* Adds an observed DB degradation (per unit of mass) to the pseudo-costs */
+void MEWCP_add_pseudo_cost(pseudo_costs_t * pseudo_costs, const int split_node, const bool is_left, const double unit_gain);
+
+/* Called when a son has been bounded: its DB degradation goes into the pseudo-costs */
+void MEWCP_update_pseudo_costs(pseudo_costs_t * pseudo_costs, open_node_t * son);
 /*
  * Generate a new list of blocked nodes based on an old blocked list end equibranch decision 
  * branch_num_part is the number of partition 0,...,m-1
@@ -210,13 +702,69 @@ void MEWCP_generate_list_blocked_nodes_branching_sons(list_blocked_nodes_t * fat
         const unsigned int num_nodes,
         const unsigned int cardinality_partition  );
 
-/* Execute sd to the open_node */
-void MEWCP_bound(open_node_t * open_node, constraint_t * constraints_matrix,matrix_weights_t * matrix_weigths, double * bi,
+/* Execute sd to the open_node, the buffers are the ones of the workspace of the worker */
+void MEWCP_bound(open_node_t * open_node, bound_workspace_t * workspace, constraint_t * constraints_matrix,matrix_weights_t * matrix_weigths, double * bi,
                  const unsigned int num_constraints,
                  const unsigned int dim_matrix,
                  const unsigned int num_nodes,
                  const unsigned int num_partitions,
-                 const double best_PB);
+                 const double best_PB,
+                 cut_pool_t * cut_pool);		/* if NULL the node is not cut */
+
+/* Room for the restriction of any node of the problem */
+sdp_reduction_t * MEWCP_allocate_sdp_reduction(constraint_t * constraints_matrix,
+        const unsigned int num_constraints,
+        const unsigned int num_nodes);
+/* The problem of open_node restricted to its free nodes, the fixed partitions contracted. The last one is overwritten */
+void MEWCP_reduce_sdp_problem(sdp_reduction_t * reduction, open_node_t * open_node, constraint_t * constraints_matrix, double * bi,
+        const unsigned int num_constraints,
+        const unsigned int num_nodes,
+        const unsigned int cardinality_partitions);
+
+/* Number of nodes of the fixed partitions (one free node), out_is_fixed may be NULL. Without
+ * CONTRACTED_SDP_ACTIVE, or if a partition is empty or all are fixed, none is fixed
+ */
+unsigned int MEWCP_mark_fixed_nodes(list_blocked_nodes_t * list_blocked_nodes, const unsigned int num_nodes,
+                                    const unsigned int cardinality_partitions,
+                                    bool * out_is_fixed);
+
+/* Drops the elements of the blocked nodes from a packed matrix, the rest are renumbered on the free
+ * nodes and the ones of the fixed nodes are contracted: A.X = A'.X' + out_constant.
+ * Returns the number of elements left
+ */
+int MEWCP_restrict_packed_matrix(sdp_reduction_t * reduction, const int * index, const double * weight, const int num_nz,
+                                 int * out_index, double * out_weight, double * out_constant);
+
+/* Number of y, size of the block and value of the fixed nodes of the problem of a node, reduction may be NULL */
+unsigned int MEWCP_get_sdp_num_variables(sdp_reduction_t * reduction, const unsigned int num_constraints);
+unsigned int MEWCP_get_sdp_block_size(sdp_reduction_t * reduction, const unsigned int num_nodes);
+double MEWCP_get_sdp_fixed_value(sdp_reduction_t * reduction);
+
+/* Sets b, the data matrices and Y0 of the problem of open_node, restricted if reduction is not NULL */
+void MEWCP_load_sdp_node_problem(DSDP dsdp, SDPCone sdpcone, open_node_t * open_node,
+                                 constraint_t * constraints_matrix, double * bi,
+                                 const unsigned int num_constraints,
+                                 const unsigned int num_nodes,
+                                 sdp_reduction_t * reduction);
+
+/* Y0 from the y of the node, its diagX and y from the solution: the reduced problem is mapped back
+ * (the fixed nodes have X_ff = 1), the y of the dropped constraints are left as they are
+ */
+void MEWCP_set_node_Y0(DSDP dsdp, sdp_reduction_t * reduction, double * vect_y, const unsigned int num_constraints);
+void MEWCP_dump_node_diag_X(SDPCone * sdpcone, sdp_reduction_t * reduction, double * dst_diag_X, const unsigned int num_nodes);
+void MEWCP_dump_node_vect_y(DSDP * dsdp, sdp_reduction_t * reduction, double * dst_vect_y, const unsigned int num_constraints);
+
+/* The packed X of all the nodes: the one of DSDP, or the reduced one expanded into buffer with the fixed nodes */
+double * MEWCP_get_node_X(SDPCone * sdpcone, sdp_reduction_t * reduction, double * buffer);
+
+/* The DSDP problem of open_node, set up and not solved, with Y0 from its y */
+DSDP MEWCP_create_sdp_node_problem(open_node_t * open_node, constraint_t * constraints_matrix, double * bi,
+                                   const unsigned int num_constraints,
+                                   const unsigned int num_nodes,
+                                   sdp_reduction_t * reduction,
+                                   const double sdp_best_PB,
+                                   SDPCone * out_sdpcone);
+
 
 
 bool MEWCP_branch( open_node_t * open_node,
@@ -226,6 +774,10 @@ bool MEWCP_branch( open_node_t * open_node,
                    const unsigned int num_constraints,
                    const unsigned int father_depth_level,
                    unsigned int * serial_number_node,
+                   const unsigned int branching_rule,
+                   pseudo_costs_t * pseudo_costs,
+                   matrix_weights_t * matrix_weights,
+                   bound_workspace_t * workspace,
                    open_node_t ** out_left_son,
                    open_node_t ** out_right_son);
 
@@ -239,11 +791,61 @@ solution_bb_t * MEWCP_branch_and_bound(open_node_t * open_root_node, constraint_
                             const unsigned int num_nodes,
                             const unsigned int num_partitions,
                             double best_primal_obj,
-                            int * list_node_best_solution,double time_timit);
+                            int * list_node_best_solution,double time_timit,
+                            bb_parameters_t * bb_parameters,
+                            cut_pool_t * cut_pool);
+
+/* Main loop of a B&B worker: it pops open nodes until the tree is explored */
+void * MEWCP_bb_worker(void * arg);
+
+/* Returns NULL when the worker has to stop */
+open_node_t * MEWCP_bb_get_open_node(bb_worker_t * bb_worker);
+open_node_t * MEWCP_bb_get_open_node_stealing(bb_worker_t * bb_worker);
+
+/* Gives back the sons (NULL if closed) of the node the worker has processed */
+void MEWCP_bb_put_open_nodes(bb_worker_t * bb_worker, open_node_t * son_left, open_node_t * son_right);
+void MEWCP_bb_put_open_nodes_stealing(bb_worker_t * bb_worker, open_node_t * son_left, open_node_t * son_right);
+
+/* Takes the oldest (shallowest) node of another worker, NULL if all the lists are empty */
+open_node_t * MEWCP_bb_steal_open_node(bb_worker_t * bb_worker);
+
+/* Max DB among the open nodes of the shared list and of the workers' lists */
+double MEWCP_bb_compute_global_bound(bb_context_t * bb_context);
+
+/* Sets the stop flag and wakes up the waiting workers, mutex_list must be held */
+void MEWCP_bb_stop(list_branching_t * list_branching, const bool time_limit_reached);
+
+/* Branches the open node and bounds its sons, the sons still open are returned */
+void MEWCP_bb_process_open_node(bb_worker_t * bb_worker, open_node_t * open_node, open_node_t ** out_son_left, open_node_t ** out_son_right);
+
+/* Explicit, combinatorial, Lagrangian and semidefinite bound of a son, returns true if it has to be closed */
+bool MEWCP_bound_son(bb_worker_t * bb_worker, open_node_t * son, const bool active_combinatorial_bound);
+
+/* Time compared with the time limit */
+double MEWCP_bb_elapsed_time(bb_context_t * bb_context);
 
 
 void MEWCP_close_open_node(list_branching_t * list_branching, open_node_t * open_node);
 
+/* Tells if the combinatorial or the Lagrangian bound (bound_type) is worth to be run before the SDP one on a node at depth_level */
+bool MEWCP_bound_policy_use_bound(bound_policy_t * bound_policy, const unsigned int depth_level, const unsigned int bound_type);
+
+/* Adds a call of a bound to the statistics of the policy */
+void MEWCP_bound_policy_add(bound_policy_t * bound_policy, const unsigned int depth_level, const unsigned int bound_type,
+                            const double time, const bool closed);
+
+/* Work limit of the explicit enumeration of a node at depth_level: its predicted time is not more than
+ * the SDP way. MEWCP_MAX_EXPLICIT_WORK until both are measured
+ */
+double MEWCP_bound_policy_explicit_work(bound_policy_t * bound_policy, const unsigned int depth_level);
+
+/* Adds an explicit enumeration, with its estimated work, to the statistics of the policy */
+void MEWCP_bound_policy_add_explicit(bound_policy_t * bound_policy, const unsigned int depth_level,
+                                     const double work, const double time);
+
+/* Adds the DSDP iterations of a node bounded by SDP to the statistics */
+void MEWCP_update_sdp_statistics(list_branching_t * list_branching, open_node_t * open_node);
+
 /*
  * BRANCHING LIST FUNCIONS 
  */
@@ -261,6 +863,22 @@ open_node_t * MEWCP_pop_specific_open_node(branching_open_node_t * branching_ope
 
 bool MEWCP_is_list_branching_empty(list_branching_t * list_branching);
 branching_open_node_t * MEWCP_find_worst_bound_element(list_branching_t * list_branching );
+branching_open_node_t * MEWCP_find_deepest_element(list_branching_t * list_branching );
+branching_open_node_t * MEWCP_find_best_estimate_element(list_branching_t * list_branching );
+
+/* Returns the element of the list to be processed according to node_selection */
+branching_open_node_t * MEWCP_select_open_node(list_branching_t * list_branching, const unsigned int node_selection);
+
+/* Sets open_node->estimate from DB, PB and the fractionality of diagX */
+void MEWCP_compute_estimate(open_node_t * open_node, const unsigned int num_nodes, const unsigned int num_partitions);
+
+/* Hybrid dive: true if son is better than its brother, by DB, then estimate, then the diagX
+ * of the father they have removed */
+bool MEWCP_is_better_dive_son(open_node_t * son, open_node_t * other_son);
+
+/* The best primal can be read without locks, it is written by compare and exchange */
+double MEWCP_get_best_primal(list_branching_t * list_branching);
+void MEWCP_update_max_exploration_level(list_branching_t * list_branching, const unsigned int depth_level);
 
 
 
@@ -273,7 +891,9 @@ branching_open_node_t * MEWCP_find_worst_bound_element(list_branching_t * list_b
 void MEWCP_add_blocked_node(const unsigned int id_node, list_blocked_nodes_t * list_blocked_nodes);
 void trova_boundaries_diagonale(const unsigned int c, const unsigned int i, int * boundaries);
 unsigned int MEWCP_convert_coords_ij_to_vector_matrix(const unsigned int i, const unsigned j);
+void MEWCP_convert_vector_matrix_to_coords_ij(const unsigned int pos, unsigned int * out_i, unsigned int * out_j);	/* inverse of the above */
 void MEWCP_clone_list_blocked_modes(list_blocked_nodes_t * list_to_be_cloned, list_blocked_nodes_t * list_cloned, const unsigned int num_nodes);
+void MEWCP_reset_list_blocked_nodes(list_blocked_nodes_t * list_blocked_nodes, const unsigned int num_nodes);	/* no node blocked */
 void MEWCP_clone_vect_y(double * vect_y_to_be_cloned, double * vect_y_cloned, const unsigned int num_constraints);
 void MEWCP_clone_list_nodes_solution( int * list_to_be_cloned,  int * list_cloned, const unsigned int num_nodes);
 void MEWCP_dump_diag_X(SDPCone * sdpcone, double * dst_diag_X, const unsigned int num_nodes);
@@ -289,15 +909,63 @@ void MEWCP_compute_sdp_rounding(double * diag_X,  int * list_nodes_rounded_solut
 
 /* Calculate the Objective function related to a list_node_soluztion, the weights matrix is given into a vector of n*(n+1) elements */
 double MEWCP_evaluate_list_nodes_solution( int * list_node_solution, matrix_weights_t * matrix_weights ,const unsigned int m);
+
+/* Values of num_solutions solutions at once, solutions[t*num_solutions + s] is the node of the partition t
+ * in the solution s. The inner loop runs over the solutions, so the compiler can vectorise it with gathers
+ * where the target has them. The sums are the same as MEWCP_evaluate_list_nodes_solution
+ */
+void MEWCP_evaluate_list_nodes_solutions(const int * solutions, const unsigned int num_solutions,
+        matrix_weights_t * matrix_weights,
+        const unsigned int m,
+        double * out_values);
+
+/* The rounding in list_nodes_rounded and, for each partition, the rounding with its free node of second largest
+ * X_ii are evaluated in one batch. The best one is left in list_nodes_rounded, returns its value
+ */
+double MEWCP_evaluate_sdp_roundings(double * diag_X, int * list_nodes_rounded, list_blocked_nodes_t * list_blocked_nodes,
+        bound_workspace_t * workspace,
+        matrix_weights_t * matrix_weights,
+        const unsigned int m,
+        const unsigned int c);
+
+/* Values of the solution with each of the c nodes of the partition k in place of the taken one */
+void MEWCP_evaluate_partition_alternatives(int * list_node_solution, const double z_solution,
+        matrix_weights_t * matrix_weights,
+        const unsigned int m,
+        const unsigned int c,
+        const unsigned int k,
+        double * out_values);
+
+/* Exchanges the node of a partition with a better free one until there is none, returns the new value.
+ * values has room for c doubles
+ */
+double MEWCP_improve_list_nodes_solution(int * list_node_solution, const double z_solution,
+        list_blocked_nodes_t * list_blocked_nodes,
+        matrix_weights_t * matrix_weights,
+        const unsigned int m,
+        const unsigned int c,
+        double * values);
+/* Number of the pairs of nodes of the solution in conflict (see CONFLICTS_ACTIVE) */
+unsigned int MEWCP_count_solution_conflicts(int * list_node_solution, matrix_weights_t * matrix_weights ,const unsigned int m);
+
+/* The sorted row of the nodes in conflict with i, NULL and 0 if none */
+const unsigned int * MEWCP_get_node_conflicts(const matrix_weights_t * matrix_weights, const unsigned int i, unsigned int * out_num_conflicts);
+bool MEWCP_is_conflict(const matrix_weights_t * matrix_weights, const unsigned int i, const unsigned int j);
 int sort_compare (const void * a, const void * b);
 void Take_Time(double * user_time, double * system_time);
 double get_cpu_time(void);  // Returns cpu time in seconds user+sys
+double get_wall_time(void);  // Returns real time in seconds
+double get_thread_cpu_time(void);  // Returns cpu time of the calling thread in seconds, with ns resolution
 
 /*****  END UTILS ********/
 
 /* ALLOCATION FUNCTIONS */
 double * MEWCP_allocate_vect_y(const unsigned int num_constraints);
-constraint_t * MEWCP_allocate_sdp_constraints_matrix(const unsigned int n, const unsigned int num_constraints );
+/* The constraints without storage, the writers of converter_dsdp.c count their nonzeros */
+constraint_t * MEWCP_allocate_sdp_constraints_matrix(const unsigned int num_constraints );
+
+/* One block for the counted nonzeros of all the constraints */
+void MEWCP_allocate_sdp_constraints_storage(constraint_t * sdp_constraints_matrix, const unsigned int num_constraints );
 double * MEWCP_allocate_bi(const unsigned int num_contraints );
 list_blocked_nodes_t *  MEWCP_allocate_list_blocked_nodes(const unsigned int num_nodes );
 double * MEWCP_allocate_diag_X(const unsigned int length);
@@ -305,6 +973,13 @@ int * MEWCP_allocate_list_nodes_solution( const unsigned int m);
 constraint_t * MEWCP_allocate_vect_mat_branching_constraints(const unsigned int dim_matrix);
 open_node_t * MEWCP_allocate_open_node(void);
 solution_bb_t * MEWCP_allocate_solution_bb(unsigned int num_partitions);
+bb_worker_t * MEWCP_allocate_bb_workers(bb_context_t * bb_context);
+bound_workspace_t * MEWCP_allocate_bound_workspaces(const unsigned int num_workspaces, const unsigned int num_nodes, const unsigned int num_partitions,
+        constraint_t * constraints_matrix,
+        const unsigned int num_constraints,
+        cut_pool_t * cut_pool);
+pseudo_costs_t * MEWCP_allocate_pseudo_costs(const unsigned int num_nodes);
+bound_policy_t * MEWCP_allocate_bound_policy(void);
 
 // Print functions
 void MEWCP_print_contraints_matrix(double ** matrix, const unsigned int length_i, const unsigned int length_j);
@@ -313,6 +988,7 @@ void MEWCP_print_diag_X(double * diag_X, const unsigned int num_nodes);
 void MEWCP_print_list_blocked_nodes(list_blocked_nodes_t * list_blocked_modes);
 void MEWCP_print_list_nodes_solution( int * list_nodes_solution, const unsigned int m);
 void MEWCP_print_list_nodes_solution_cplex( int * list_nodes_solution, const unsigned int m);
+void MEWCP_print_bound_policy(bound_policy_t * bound_policy);
 
 /* FREE FUNCTIONS */
 void MEWCP_free_list_blocked_nodes(list_blocked_nodes_t * list_blocked_nodes );
@@ -324,6 +1000,11 @@ void MEWCP_free_list_nodes_solution( int * list_nodes_solution);
 void MEWCP_free_vect_mat_branching_constraints(constraint_t * vect_mat_branching_contraints);
 void MEWCP_free_open_node(open_node_t * open_node);
 void MEWCP_free_solution_bb(solution_bb_t * solution_bb);
+void MEWCP_free_sdp_reduction(sdp_reduction_t * sdp_reduction);
+void MEWCP_free_bb_workers(bb_worker_t * bb_workers, const unsigned int num_threads);
+void MEWCP_free_bound_workspaces(bound_workspace_t * bound_workspaces, const unsigned int num_workspaces);
+void MEWCP_free_pseudo_costs(pseudo_costs_t * pseudo_costs);
+void MEWCP_free_bound_policy(bound_policy_t * bound_policy);
 
 
 #endif /*MEWCP_DSDP_H_*/
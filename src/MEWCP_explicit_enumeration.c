@@ -26,9 +26,10 @@
  */
 
 
-void MEWCP_bound_explicit(open_node_t * open_node, matrix_weights_t * matrix_weights,
+void MEWCP_bound_explicit(open_node_t * open_node, bound_workspace_t * workspace, matrix_weights_t * matrix_weights,
                           const unsigned num_partitions,
-                          const unsigned int cardinality_partitions)
+                          const unsigned int cardinality_partitions,
+                          const double best_primal)
 
 {
 
@@ -37,17 +38,39 @@ void MEWCP_bound_explicit(open_node_t * open_node, matrix_weights_t * matrix_wei
 #endif
 
     double z_best;
-    open_node->list_nodes_solution = MEWCP_allocate_list_nodes_solution(num_partitions);
+    if (open_node->list_nodes_solution == NULL)
+    {
+        open_node->list_nodes_solution = MEWCP_allocate_list_nodes_solution(num_partitions);
+    }
 
+#if defined EXPLICIT_DFS_ACTIVE
+    MEWCP_compute_explicit_dfs(open_node->list_blocked_nodes,
+                               workspace,
+                               matrix_weights,
+                               num_partitions,
+                               cardinality_partitions,
+                               best_primal,
+                               open_node->list_nodes_solution,
+                               &z_best);
+#else
     MEWCP_compute_explicit_enumeration(open_node->list_blocked_nodes,
+                                       workspace,
                                        matrix_weights,
                                        num_partitions,
                                        cardinality_partitions,
                                        open_node->list_nodes_solution,
                                        &z_best);
+#endif
 
     open_node->PB = z_best;
     open_node->DB = z_best;
+#if defined EXPLICIT_DFS_ACTIVE
+    if (z_best <= MEWCP_MIN_DOUBLE)
+    {
+        /* Nothing better than the best primal */
+        open_node->DB = best_primal;
+    }
+#endif
 #if defined MEWCP_BOUNDING_VERBOSE1
 
     printf("<< EXPLICIT Enumeration: (%d) (P) Z: %.2lf \t level: %u\n",open_node->serial_node, z_best, open_node->depth_level);
@@ -56,7 +79,235 @@ void MEWCP_bound_explicit(open_node_t * open_node, matrix_weights_t * matrix_wei
 }
 
 
+void MEWCP_bound_explicit_parallel(open_node_t * open_node, bound_workspace_t * bound_workspaces,
+                                   const unsigned int num_threads,
+                                   matrix_weights_t * matrix_weights,
+                                   const unsigned num_partitions,
+                                   const unsigned int cardinality_partitions,
+                                   const double best_primal)
+{
+#if defined MEWCP_EXPLICIT_ENUMERATION_DEBUG
+    printf("* MEWCP_bound_explicit_parallel: %d *\n",open_node->serial_node);
+#endif
+
+    unsigned int i,d,num_free;
+    double z_best;
+    unsigned int best_task;
+    explicit_context_t explicit_context;
+    explicit_worker_t * explicit_workers;
+    list_free_variables_partitions_t * list_free_variables_partitions;
+
+#if defined EXPLICIT_DFS_ACTIVE
+    if ( (num_threads > 1) && (num_partitions > 1) &&
+            (MEWCP_prepare_explicit_dfs(open_node->list_blocked_nodes,&bound_workspaces[0],matrix_weights,num_partitions,cardinality_partitions,0) == true) )
+    {
+        /* The largest partitions are split until each thread has a few tasks, one partition is left to the search */
+        list_free_variables_partitions = bound_workspaces[0].list_free_variables_partitions;
+        explicit_context.num_split_partitions = 0;
+        explicit_context.num_tasks = 1;
+        for (d=num_partitions-1; (d>0) && (explicit_context.num_tasks < MEWCP_EXPLICIT_TASKS_PER_THREAD*num_threads); --d)
+        {
+            num_free = list_free_variables_partitions[bound_workspaces[0].dfs_partitions[d]].number_free_nodes;
+            explicit_context.num_tasks *= num_free;
+            explicit_context.num_split_partitions++;
+        }
+
+        explicit_context.list_blocked_nodes = open_node->list_blocked_nodes;
+        explicit_context.matrix_weights = matrix_weights;
+        explicit_context.num_partitions = num_partitions;
+        explicit_context.cardinality_partitions = cardinality_partitions;
+        explicit_context.next_task = 0;
+        explicit_context.best_primal = best_primal;
+
+        explicit_workers = (explicit_worker_t *) calloc(num_threads,sizeof(explicit_worker_t));
+        if (explicit_workers == NULL)
+        {
+            printf("!!! ERROR allocation explicit_workers! \n");
+            exit(EXIT_FAILURE);
+        }
+        for (i=0; i<num_threads; ++i)
+        {
+            explicit_workers[i].id_worker = i;
+            explicit_workers[i].explicit_context = &explicit_context;
+            explicit_workers[i].workspace = &bound_workspaces[i];
+            explicit_workers[i].task_list_nodes_solution = MEWCP_allocate_list_nodes_solution(num_partitions);
+            explicit_workers[i].best_list_nodes_solution = MEWCP_allocate_list_nodes_solution(num_partitions);
+        }
+
+        for (i=0; i<num_threads; ++i)
+        {
+            if (pthread_create(&explicit_workers[i].thread, NULL, MEWCP_explicit_worker, &explicit_workers[i]) != 0)
+            {
+                printf("!!! ERROR creation of explicit worker %u! \n",i);
+                exit(EXIT_FAILURE);
+            }
+        }
+        for (i=0; i<num_threads; ++i)
+        {
+            pthread_join(explicit_workers[i].thread, NULL);
+        }
+
+        if (open_node->list_nodes_solution == NULL)
+        {
+            open_node->list_nodes_solution = MEWCP_allocate_list_nodes_solution(num_partitions);
+        }
+
+        /* The best values are the same whatever the schedule, among them the first task wins */
+        z_best = MEWCP_MIN_DOUBLE;
+        best_task = explicit_context.num_tasks;
+        for (i=0; i<num_threads; ++i)
+        {
+            if (explicit_workers[i].best_task == explicit_context.num_tasks)
+            {
+                continue;
+            }
+            if ( ((explicit_workers[i].z_best - z_best) > MEWCP_EPSILON) ||
+                    ( ((z_best - explicit_workers[i].z_best) <= MEWCP_EPSILON) && (explicit_workers[i].best_task < best_task) ) )
+            {
+                z_best = explicit_workers[i].z_best;
+                best_task = explicit_workers[i].best_task;
+                MEWCP_clone_list_nodes_solution(explicit_workers[i].best_list_nodes_solution,open_node->list_nodes_solution,num_partitions);
+            }
+        }
+
+        for (i=0; i<num_threads; ++i)
+        {
+            MEWCP_free_list_nodes_solution(explicit_workers[i].task_list_nodes_solution);
+            MEWCP_free_list_nodes_solution(explicit_workers[i].best_list_nodes_solution);
+        }
+        free(explicit_workers);
+
+        open_node->PB = z_best;
+        open_node->DB = z_best;
+        if (z_best <= MEWCP_MIN_DOUBLE)
+        {
+            /* Nothing better than the best primal */
+            open_node->DB = best_primal;
+        }
+#if defined MEWCP_BOUNDING_VERBOSE1
+
+        printf("<< EXPLICIT Enumeration: (%d) (P) Z: %.2lf \t level: %u\t tasks: %u\n",open_node->serial_node, z_best, open_node->depth_level,explicit_context.num_tasks);
+#endif
+        return;
+    }
+#endif
+
+    MEWCP_bound_explicit(open_node,&bound_workspaces[0],matrix_weights,num_partitions,cardinality_partitions,best_primal);
+}
+
+
+void * MEWCP_explicit_worker(void * arg)
+{
+    explicit_worker_t * explicit_worker = (explicit_worker_t *) arg;
+    explicit_context_t * explicit_context = explicit_worker->explicit_context;
+    bound_workspace_t * workspace = explicit_worker->workspace;
+    matrix_weights_t * matrix_weights = explicit_context->matrix_weights;
+    unsigned int num_partitions = explicit_context->num_partitions;
+    unsigned int num_split_partitions = explicit_context->num_split_partitions;
+    list_free_variables_partitions_t * list_free_variables_partitions;
+    unsigned int task,rest,d,k,num_fixed;
+    unsigned int num_free;
+    int v;
+    double value;
+    double bound;
+    double best_primal;
+    double z_task;
+
+    explicit_worker->z_best = MEWCP_MIN_DOUBLE;
+    explicit_worker->best_task = explicit_context->num_tasks;
+
+    /* Same order as the caller: the split partitions lead */
+    MEWCP_prepare_explicit_dfs(explicit_context->list_blocked_nodes,workspace,matrix_weights,num_partitions,
+                               explicit_context->cardinality_partitions,num_split_partitions);
+    list_free_variables_partitions = workspace->list_free_variables_partitions;
+
+    while (true)
+    {
+        task = __atomic_fetch_add(&explicit_context->next_task, 1, __ATOMIC_RELAXED);
+        if (task >= explicit_context->num_tasks)
+        {
+            break;
+        }
+
+        /* The task is a mixed radix number, its digits are the choices in the split partitions */
+        rest = task;
+        for (d=num_split_partitions; d>0; --d)
+        {
+            k = workspace->dfs_partitions[d-1];
+            num_free = (unsigned int) list_free_variables_partitions[k].number_free_nodes;
+            workspace->ithsolution[k] = list_free_variables_partitions[k].free_nodes[rest % num_free];
+            rest /= num_free;
+        }
+
+        value = 0;
+        for (num_fixed=0; num_fixed<num_split_partitions; ++num_fixed)
+        {
+            v = workspace->ithsolution[workspace->dfs_partitions[num_fixed]];
+            if (workspace->dfs_conflicts[v] > 0)
+            {
+                break;
+            }
+            value += matrix_weights->weight[v][v] + workspace->dfs_links[v];
+            MEWCP_link_explicit_node(workspace,matrix_weights,num_partitions,num_fixed,v,true);
+        }
+
+        /* Each task looks for its own first best solution, the shared primal only cuts what cannot win */
+        z_task = MEWCP_MIN_DOUBLE;
+        if (num_fixed == num_split_partitions)
+        {
+            __atomic_load(&explicit_context->best_primal, &best_primal, __ATOMIC_RELAXED);
+            bound = MEWCP_bound_explicit_completion(workspace,matrix_weights,num_partitions,num_split_partitions,value);
+            if ( (bound > MEWCP_MIN_DOUBLE) && ((best_primal - bound) <= MEWCP_EPSILON) )
+            {
+                MEWCP_explicit_dfs_level(workspace,matrix_weights,num_partitions,num_split_partitions,value,best_primal,
+                                         explicit_worker->task_list_nodes_solution,&z_task);
+            }
+        }
+
+        for (d=num_fixed; d>0; --d)
+        {
+            v = workspace->ithsolution[workspace->dfs_partitions[d-1]];
+            MEWCP_link_explicit_node(workspace,matrix_weights,num_partitions,d-1,v,false);
+        }
+
+        if (z_task <= MEWCP_MIN_DOUBLE)
+        {
+            continue;
+        }
+        MEWCP_update_explicit_best_primal(explicit_context,z_task);
+
+        /* The tasks of a worker grow, an equal value keeps the earlier one */
+        if ((z_task - explicit_worker->z_best) > MEWCP_EPSILON)
+        {
+            explicit_worker->z_best = z_task;
+            explicit_worker->best_task = task;
+            MEWCP_clone_list_nodes_solution(explicit_worker->task_list_nodes_solution,explicit_worker->best_list_nodes_solution,num_partitions);
+        }
+    }
+
+    return NULL;
+}
+
+
+void MEWCP_update_explicit_best_primal(explicit_context_t * explicit_context, double primal)
+{
+    double best_primal;
+
+    __atomic_load(&explicit_context->best_primal, &best_primal, __ATOMIC_RELAXED);
+
+    while ( (primal - best_primal) >  MEWCP_EPSILON)
+    {
+        if (__atomic_compare_exchange(&explicit_context->best_primal, &best_primal, &primal,
+                                      false, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == true)
+        {
+            break;
+        }
+    }
+}
+
+
 void MEWCP_compute_explicit_enumeration(list_blocked_nodes_t * list_blocked_nodes,
+                                        bound_workspace_t * workspace,
                                         matrix_weights_t * matrix_weights,
                                         const unsigned num_partitions,
                                         const unsigned int cardinality_partitions,
@@ -67,14 +318,20 @@ void MEWCP_compute_explicit_enumeration(list_blocked_nodes_t * list_blocked_node
     printf("* MEWCP_compute_explicit_enumeration *\n");
 #endif
 
-    int cin;
-    unsigned int i,k;
+    unsigned int i,k,t,g;
+    unsigned int num_gray_partitions;
+    unsigned int num_conflicting_pairs;
+    int old_node;
+    int new_node;
     double z_best;
     double z_ith;
     unsigned long long int num_solutions;
 
-    unsigned int pos_k[num_partitions];
-    int ithsolution[num_partitions];
+    unsigned int * pos_k = workspace->pos_k;
+    int * ithsolution = workspace->ithsolution;
+    unsigned int * gray_partitions = workspace->gray_partitions;
+    unsigned int * focus_pointers = workspace->focus_pointers;
+    int * directions = workspace->directions;
 
 #if defined MEWCP_EXPLICIT_ENUMERATION_DEBUG
 
@@ -84,7 +341,7 @@ void MEWCP_compute_explicit_enumeration(list_blocked_nodes_t * list_blocked_node
     list_free_variables_partitions_t * list_free_variables_partitions;
 
 
-    list_free_variables_partitions = MEWCP_allocate_list_free_varibles_partitions(num_partitions,cardinality_partitions);
+    list_free_variables_partitions = workspace->list_free_variables_partitions;
     MEWCP_generate_list_free_varibles_partitions(list_blocked_nodes ,list_free_variables_partitions,num_partitions,cardinality_partitions);
 
     /* Let's count the solutions */
@@ -100,50 +357,80 @@ void MEWCP_compute_explicit_enumeration(list_blocked_nodes_t * list_blocked_node
 
     z_best = MEWCP_MIN_DOUBLE;
 
-    // Initializes the position
-    for (i =0; i< num_partitions;++i)
+    if (num_solutions == 0)
     {
-
-        pos_k[i] = 0;
+        /* A partition has no free node */
+        *out_z_best_solution = z_best;
+        return;
     }
 
-
-    do
+    /* Mixed-radix reflected Gray code (Knuth, loopless algorithm H) on the partitions with more
+     * than one free node: at each step only one partition moves to the next or previous free node,
+     * so the objective and the conflicts of the solution are updated in O(m)
+     */
+    num_gray_partitions = 0;
+    for (k =0; k< num_partitions;++k)
     {
-
-        for(i=0;i<num_partitions;++i)
+        pos_k[k] = 0;
+        ithsolution[k] = list_free_variables_partitions[k].free_nodes[0];
+        if (list_free_variables_partitions[k].number_free_nodes > 1)
         {
-            ithsolution[i] = list_free_variables_partitions[i].free_nodes[pos_k[i] ];
-            //printf("%d ",ithsolution[i]);
-
+            gray_partitions[num_gray_partitions] = k;
+            focus_pointers[num_gray_partitions] = num_gray_partitions;
+            directions[num_gray_partitions] = 1;
+            num_gray_partitions++;
         }
-        z_ith = MEWCP_evaluate_list_nodes_solution(ithsolution,matrix_weights,num_partitions);
-
-
-        //printf(" z: %.2lf\n",z_ith);
-
+    }
+    focus_pointers[num_gray_partitions] = num_gray_partitions;
 
+    z_ith = MEWCP_evaluate_list_nodes_solution(ithsolution,matrix_weights,num_partitions);
+    num_conflicting_pairs = MEWCP_count_solution_conflicts(ithsolution,matrix_weights,num_partitions);
 
-        if  (( z_ith - z_best) > MEWCP_EPSILON)
+    while (true)
+    {
+        /* A solution with a conflict is worse than the incumbent */
+        if  ( (num_conflicting_pairs == 0) && (( z_ith - z_best) > MEWCP_EPSILON) )
         {
             z_best = z_ith;
             MEWCP_clone_list_nodes_solution(ithsolution,out_best_list_nodes_solution,num_partitions);
         }
 
-
-        cin = -1;
-        do
+        g = focus_pointers[0];
+        focus_pointers[0] = 0;
+        if (g == num_gray_partitions)
         {
-            cin += 1;
-            //printf("cin: %d ",cin);
-            pos_k[cin] = (pos_k[cin] + 1) % list_free_variables_partitions[cin].number_free_nodes;
-
+            break;
         }
-        while ((pos_k[cin ] == 0) && (cin<num_partitions-1) );
 
+        k = gray_partitions[g];
+        old_node = ithsolution[k];
+        pos_k[k] += directions[g];
+        new_node = list_free_variables_partitions[k].free_nodes[pos_k[k]];
+
+        /* Only the terms of the partition k change */
+        z_ith += matrix_weights->weight[new_node][new_node] - matrix_weights->weight[old_node][old_node];
+        for (t=0; t<num_partitions; ++t)
+        {
+            if (t == k)
+            {
+                continue;
+            }
+            z_ith += matrix_weights->weight[new_node][ithsolution[t]] - matrix_weights->weight[old_node][ithsolution[t]];
+            if (matrix_weights->conflict_start != NULL)
+            {
+                num_conflicting_pairs += MEWCP_is_conflict(matrix_weights,new_node,ithsolution[t]);
+                num_conflicting_pairs -= MEWCP_is_conflict(matrix_weights,old_node,ithsolution[t]);
+            }
+        }
+        ithsolution[k] = new_node;
 
+        if ( (pos_k[k] == 0) || (pos_k[k] == (unsigned int) list_free_variables_partitions[k].number_free_nodes -1) )
+        {
+            directions[g] = -directions[g];
+            focus_pointers[g] = focus_pointers[g+1];
+            focus_pointers[g+1] = g+1;
+        }
     }
-    while( !( (cin == num_partitions - 1)  && (pos_k[num_partitions-1] == 0 ) ));
 
 
 
@@ -164,12 +451,296 @@ void MEWCP_compute_explicit_enumeration(list_blocked_nodes_t * list_blocked_node
 #endif
 
     *out_z_best_solution = z_best;
-    MEWCP_free_list_free_varibles_partitions(list_free_variables_partitions,num_partitions);
 
 
 }
 
 
+void MEWCP_compute_explicit_dfs(list_blocked_nodes_t * list_blocked_nodes,
+                                bound_workspace_t * workspace,
+                                matrix_weights_t * matrix_weights,
+                                const unsigned num_partitions,
+                                const unsigned int cardinality_partitions,
+                                const double best_primal,
+                                int * out_best_list_nodes_solution,
+                                double * out_z_best_solution)
+{
+#if defined MEWCP_EXPLICIT_ENUMERATION_DEBUG
+    printf("* MEWCP_compute_explicit_dfs *\n");
+#endif
+
+    double z_best;
+
+    z_best = MEWCP_MIN_DOUBLE;
+    *out_z_best_solution = z_best;
+
+    if (MEWCP_prepare_explicit_dfs(list_blocked_nodes,workspace,matrix_weights,num_partitions,cardinality_partitions,0) == false)
+    {
+        /* A partition has no free node */
+        return;
+    }
+
+    MEWCP_explicit_dfs_level(workspace,matrix_weights,num_partitions,0,0,best_primal,out_best_list_nodes_solution,&z_best);
+
+    *out_z_best_solution = z_best;
+}
+
+
+bool MEWCP_prepare_explicit_dfs(list_blocked_nodes_t * list_blocked_nodes,
+                                bound_workspace_t * workspace,
+                                matrix_weights_t * matrix_weights,
+                                const unsigned num_partitions,
+                                const unsigned int cardinality_partitions,
+                                const unsigned int num_split_partitions)
+{
+    unsigned int k,t,r,q,d;
+    int i,j;
+    double best_edge;
+    list_free_variables_partitions_t * list_free_variables_partitions;
+    unsigned int * dfs_partitions = workspace->dfs_partitions;
+
+    MEWCP_order_explicit_partitions(list_blocked_nodes,workspace,num_partitions,cardinality_partitions);
+    list_free_variables_partitions = workspace->list_free_variables_partitions;
+
+    if (list_free_variables_partitions[dfs_partitions[0]].number_free_nodes == 0)
+    {
+        return false;
+    }
+
+    if (num_split_partitions > 0)
+    {
+        /* The largest partitions go first, largest first, the others stay by increasing size */
+        for (d=0; d<num_partitions/2; ++d)
+        {
+            t = dfs_partitions[d];
+            dfs_partitions[d] = dfs_partitions[num_partitions-1-d];
+            dfs_partitions[num_partitions-1-d] = t;
+        }
+        for (d=0; d<(num_partitions-num_split_partitions)/2; ++d)
+        {
+            t = dfs_partitions[num_split_partitions+d];
+            dfs_partitions[num_split_partitions+d] = dfs_partitions[num_partitions-1-d];
+            dfs_partitions[num_partitions-1-d] = t;
+        }
+    }
+
+    /* Nothing is fixed: no links, all the best edges remain */
+    for (k=0; k<num_partitions; ++k)
+    {
+        for (r=0; r<(unsigned int) list_free_variables_partitions[k].number_free_nodes; ++r)
+        {
+            i = list_free_variables_partitions[k].free_nodes[r];
+            workspace->dfs_links[i] = 0;
+            workspace->dfs_remainders[i] = 0;
+            workspace->dfs_conflicts[i] = 0;
+            for (t=0; t<num_partitions; ++t)
+            {
+                if (t == k)
+                {
+                    continue;
+                }
+                best_edge = MEWCP_MIN_DOUBLE;
+                for (q=0; q<(unsigned int) list_free_variables_partitions[t].number_free_nodes; ++q)
+                {
+                    j = list_free_variables_partitions[t].free_nodes[q];
+                    if (matrix_weights->weight[i][j] > best_edge)
+                    {
+                        best_edge = matrix_weights->weight[i][j];
+                    }
+                }
+                workspace->dfs_best_edges[i*num_partitions + t] = best_edge;
+                workspace->dfs_remainders[i] += best_edge;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+void MEWCP_explicit_dfs_level(bound_workspace_t * workspace,
+                              matrix_weights_t * matrix_weights,
+                              const unsigned num_partitions,
+                              const unsigned int depth,
+                              const double partial_value,
+                              const double best_primal,
+                              int * out_best_list_nodes_solution,
+                              double * z_best)
+{
+    unsigned int k,r;
+    int v;
+    double value;
+    double bound;
+    list_free_variables_partitions_t * list_free_variables_partitions = workspace->list_free_variables_partitions;
+    double * dfs_links = workspace->dfs_links;
+    unsigned int * dfs_conflicts = workspace->dfs_conflicts;
+    int * ithsolution = workspace->ithsolution;
+
+    k = workspace->dfs_partitions[depth];
+
+    if (depth == num_partitions -1)
+    {
+        /* Last partition: its links are the whole value */
+        for (r=0; r<(unsigned int) list_free_variables_partitions[k].number_free_nodes; ++r)
+        {
+            v = list_free_variables_partitions[k].free_nodes[r];
+            if (dfs_conflicts[v] > 0)
+            {
+                continue;
+            }
+            value = partial_value + matrix_weights->weight[v][v] + dfs_links[v];
+            if ((value - *z_best) > MEWCP_EPSILON)
+            {
+                *z_best = value;
+                ithsolution[k] = v;
+                MEWCP_clone_list_nodes_solution(ithsolution,out_best_list_nodes_solution,num_partitions);
+            }
+        }
+        return;
+    }
+
+    for (r=0; r<(unsigned int) list_free_variables_partitions[k].number_free_nodes; ++r)
+    {
+        v = list_free_variables_partitions[k].free_nodes[r];
+        if (dfs_conflicts[v] > 0)
+        {
+            continue;
+        }
+        value = partial_value + matrix_weights->weight[v][v] + dfs_links[v];
+        ithsolution[k] = v;
+
+        MEWCP_link_explicit_node(workspace,matrix_weights,num_partitions,depth,v,true);
+        bound = MEWCP_bound_explicit_completion(workspace,matrix_weights,num_partitions,depth+1,value);
+
+        if ( ((bound - *z_best) > MEWCP_EPSILON) && ((best_primal - bound) <= MEWCP_EPSILON) )
+        {
+            MEWCP_explicit_dfs_level(workspace,matrix_weights,num_partitions,depth+1,value,best_primal,out_best_list_nodes_solution,z_best);
+        }
+
+        MEWCP_link_explicit_node(workspace,matrix_weights,num_partitions,depth,v,false);
+    }
+}
+
+
+void MEWCP_link_explicit_node(bound_workspace_t * workspace,
+                              matrix_weights_t * matrix_weights,
+                              const unsigned num_partitions,
+                              const unsigned int depth,
+                              const int v,
+                              const bool fix)
+{
+    unsigned int d,k,t,q,r;
+    unsigned int num_conflicts_v;
+    int x;
+    const unsigned int * conflicts_v;
+    list_free_variables_partitions_t * list_free_variables_partitions = workspace->list_free_variables_partitions;
+    unsigned int * dfs_partitions = workspace->dfs_partitions;
+
+    k = dfs_partitions[depth];
+
+    /* A fixed v links the nodes to fix and takes their best edge towards k, a released one gives them back */
+    for (d=depth+1; d<num_partitions; ++d)
+    {
+        t = dfs_partitions[d];
+        for (q=0; q<(unsigned int) list_free_variables_partitions[t].number_free_nodes; ++q)
+        {
+            x = list_free_variables_partitions[t].free_nodes[q];
+            if (fix == true)
+            {
+                workspace->dfs_links[x] += matrix_weights->weight[x][v];
+                workspace->dfs_remainders[x] -= workspace->dfs_best_edges[x*num_partitions + k];
+            }
+            else
+            {
+                workspace->dfs_links[x] -= matrix_weights->weight[x][v];
+                workspace->dfs_remainders[x] += workspace->dfs_best_edges[x*num_partitions + k];
+            }
+        }
+    }
+
+    /* Only the row of v: a count is read while the nodes linked are the ones of the partitions fixed before */
+    conflicts_v = MEWCP_get_node_conflicts(matrix_weights,v,&num_conflicts_v);
+    for (r=0; r<num_conflicts_v; ++r)
+    {
+        if (fix == true)
+        {
+            workspace->dfs_conflicts[conflicts_v[r]]++;
+        }
+        else
+        {
+            workspace->dfs_conflicts[conflicts_v[r]]--;
+        }
+    }
+}
+
+
+double MEWCP_bound_explicit_completion(bound_workspace_t * workspace,
+                                       matrix_weights_t * matrix_weights,
+                                       const unsigned num_partitions,
+                                       const unsigned int depth,
+                                       const double partial_value)
+{
+    unsigned int d,t,q;
+    int x;
+    double bound;
+    double best_t;
+    double tmp;
+    list_free_variables_partitions_t * list_free_variables_partitions = workspace->list_free_variables_partitions;
+
+    /* Optimistic completion: each partition to fix takes its best node, the edges among them are halved */
+    bound = partial_value;
+    for (d=depth; d<num_partitions; ++d)
+    {
+        t = workspace->dfs_partitions[d];
+        best_t = MEWCP_MIN_DOUBLE;
+        for (q=0; q<(unsigned int) list_free_variables_partitions[t].number_free_nodes; ++q)
+        {
+            x = list_free_variables_partitions[t].free_nodes[q];
+            if (workspace->dfs_conflicts[x] > 0)
+            {
+                continue;
+            }
+            tmp = matrix_weights->weight[x][x] + workspace->dfs_links[x] + workspace->dfs_remainders[x]/2;
+            if (tmp > best_t)
+            {
+                best_t = tmp;
+            }
+        }
+        if (best_t <= MEWCP_MIN_DOUBLE)
+        {
+            return MEWCP_MIN_DOUBLE;
+        }
+        bound += best_t;
+    }
+
+    return bound;
+}
+
+
+void MEWCP_order_explicit_partitions(list_blocked_nodes_t * list_blocked_nodes, bound_workspace_t * workspace,
+                                     const unsigned int num_partitions,
+                                     const unsigned int cardinality_partitions)
+{
+    unsigned int d,k;
+    list_free_variables_partitions_t * list_free_variables_partitions = workspace->list_free_variables_partitions;
+
+    MEWCP_generate_list_free_varibles_partitions(list_blocked_nodes,list_free_variables_partitions,num_partitions,cardinality_partitions);
+
+    /* Insertion sort, the partitions with few free nodes first */
+    for (k=0; k<num_partitions; ++k)
+    {
+        d = k;
+        while ( (d > 0) &&
+                (list_free_variables_partitions[workspace->dfs_partitions[d-1]].number_free_nodes > list_free_variables_partitions[k].number_free_nodes) )
+        {
+            workspace->dfs_partitions[d] = workspace->dfs_partitions[d-1];
+            d--;
+        }
+        workspace->dfs_partitions[d] = k;
+    }
+}
+
+
 void MEWCP_generate_list_free_varibles_partitions( list_blocked_nodes_t * list_blocked_nodes,
         list_free_variables_partitions_t *  list_free_variables_partitions,
         const unsigned int num_partitions,
@@ -214,13 +785,13 @@ bool MEWCP_is_node_little_enough(list_blocked_nodes_t * list_blocked_nodes,
 {
 
 
-    unsigned int dimension[num_partitions];
+    unsigned int dimension;
     unsigned int k,i;
-    long long unsigned int number_solutions = 0;
+    long long unsigned int number_solutions = 1;
 
     for(k=0;k<num_partitions;++k)
     {
-        dimension[k] = 0; // initialize
+        dimension = 0; // initialize
 
         for(i=k*cardinality_partitions ; i<k*cardinality_partitions + cardinality_partitions; ++i)
         {
@@ -229,16 +800,12 @@ bool MEWCP_is_node_little_enough(list_blocked_nodes_t * list_blocked_nodes,
             if(list_blocked_nodes->bool_list[i] == false )
             {
 
-                dimension[k] += 1;
+                dimension += 1;
 
             }
         }
-    }
 
-    number_solutions = dimension[0];
-    for(i=1;i<num_partitions;++i)
-    {
-        number_solutions *= dimension[i];
+        number_solutions *= dimension;
         // if block that avoid overflow
         if (number_solutions > max_solutions )
         {
@@ -267,6 +834,81 @@ bool MEWCP_is_node_little_enough(list_blocked_nodes_t * list_blocked_nodes,
 }
 
 
+double MEWCP_estimate_explicit_work(list_blocked_nodes_t * list_blocked_nodes, bound_workspace_t * workspace,
+                                    const unsigned int num_partitions,
+                                    const unsigned int cardinality_partitions,
+                                    const double max_work)
+{
+    unsigned int d,k;
+    double num_free_nodes = 0;
+    double num_dfs_nodes = 1;
+    double work = 0;
+    list_free_variables_partitions_t * list_free_variables_partitions = workspace->list_free_variables_partitions;
+
+    MEWCP_order_explicit_partitions(list_blocked_nodes,workspace,num_partitions,cardinality_partitions);
+
+    for (k=0; k<num_partitions; ++k)
+    {
+        num_free_nodes += list_free_variables_partitions[k].number_free_nodes;
+    }
+
+    for (d=0; d<num_partitions; ++d)
+    {
+        k = workspace->dfs_partitions[d];
+        num_dfs_nodes *= list_free_variables_partitions[k].number_free_nodes;
+        if (d < num_partitions -1)
+        {
+            /* Each node of the depth d+1 updates, bounds and releases the free nodes */
+            work += num_dfs_nodes * 3 * num_free_nodes;
+        }
+        else
+        {
+            work += num_dfs_nodes;
+        }
+
+        if (work > max_work)
+        {
+            break;
+        }
+    }
+
+#if defined MEWCP_EXPLICIT_ENUMERATION_DEBUG
+    printf("Explicit work: %.0lf\n",work);
+#endif
+
+    return work;
+}
+
+
+bool MEWCP_is_node_explicit(list_blocked_nodes_t * list_blocked_nodes, bound_workspace_t * workspace,
+                            const unsigned int num_partitions,
+                            const unsigned int cardinality_partitions)
+{
+#if defined EXPLICIT_DFS_ACTIVE
+    return (MEWCP_estimate_explicit_work(list_blocked_nodes,workspace,num_partitions,cardinality_partitions,MEWCP_MAX_EXPLICIT_WORK) <= MEWCP_MAX_EXPLICIT_WORK);
+#else
+    return MEWCP_is_node_little_enough(list_blocked_nodes,num_partitions,cardinality_partitions,MEWCP_MAX_EXPLICIT_SOLUTIONS);
+#endif
+}
+
+
+bool MEWCP_is_root_explicit(list_blocked_nodes_t * list_blocked_nodes, bound_workspace_t * workspace,
+                            const unsigned int num_partitions,
+                            const unsigned int cardinality_partitions,
+                            const unsigned int num_threads)
+{
+#if defined EXPLICIT_DFS_ACTIVE
+    double max_work;
+
+    /* All the threads enumerate the root */
+    max_work = (double) MEWCP_MAX_EXPLICIT_WORK * num_threads;
+    return (MEWCP_estimate_explicit_work(list_blocked_nodes,workspace,num_partitions,cardinality_partitions,max_work) <= max_work);
+#else
+    return MEWCP_is_node_explicit(list_blocked_nodes,workspace,num_partitions,cardinality_partitions);
+#endif
+}
+
+
 
 
 /*
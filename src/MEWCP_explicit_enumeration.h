@@ -30,13 +30,57 @@ typedef struct element_free_variables_partitions_s
 }
 list_free_variables_partitions_t;
 
+/* Explicit enumeration of the root shared by the workers */
+typedef struct explicit_context_s
+{
+    list_blocked_nodes_t * list_blocked_nodes;
+    matrix_weights_t * matrix_weights;
+    unsigned int num_partitions;
+    unsigned int cardinality_partitions;
+    unsigned int num_split_partitions;	/* the largest partitions, their choices make the tasks */
+    unsigned int num_tasks;
+    unsigned int next_task;	/* first task not taken yet, atomic */
+    double best_primal;		/* atomic, updated by compare and exchange */
+}
+explicit_context_t;
+
+typedef struct explicit_worker_s
+{
+    unsigned int id_worker;
+    pthread_t thread;
+    explicit_context_t * explicit_context;
+    bound_workspace_t * workspace;
+    int * task_list_nodes_solution;
+    int * best_list_nodes_solution;
+    double z_best;		/* best of its tasks */
+    unsigned int best_task;	/* num_tasks if none */
+}
+explicit_worker_t;
+
 
 /*
  * Prototypes 
  */
-void MEWCP_bound_explicit(open_node_t * open_node, matrix_weights_t * matrix_weights, 
+/* The best solution of the node. With EXPLICIT_DFS_ACTIVE the solutions not better than best_primal
+ * are pruned: if there is none the node gets MEWCP_MIN_DOUBLE */
+void MEWCP_bound_explicit(open_node_t * open_node, bound_workspace_t * workspace, matrix_weights_t * matrix_weights, 
 							const unsigned num_partitions, 
-							const unsigned int cardinality_partitions);
+							const unsigned int cardinality_partitions,
+							const double best_primal);
+
+/* MEWCP_bound_explicit with the depth first enumeration split among the threads, the solution does not
+ * depend on the schedule. Falls back to the first workspace with one thread
+ */
+void MEWCP_bound_explicit_parallel(open_node_t * open_node, bound_workspace_t * bound_workspaces,
+							const unsigned int num_threads,
+							matrix_weights_t * matrix_weights,
+							const unsigned num_partitions,
+							const unsigned int cardinality_partitions,
+							const double best_primal);
+
+void * MEWCP_explicit_worker(void * arg);
+
+void MEWCP_update_explicit_best_primal(explicit_context_t * explicit_context, double primal);
 
 void MEWCP_generate_list_free_varibles_partitions( list_blocked_nodes_t * list_blocked_nodes,
         list_free_variables_partitions_t *  list_free_variables_partitions,
@@ -45,6 +89,7 @@ void MEWCP_generate_list_free_varibles_partitions( list_blocked_nodes_t * list_b
 
 
 void MEWCP_compute_explicit_enumeration(list_blocked_nodes_t * list_blocked_nodes,
+                                        bound_workspace_t * workspace,
                                         matrix_weights_t * matrix_weights,
                                         const unsigned num_partitions,
                                         const unsigned int cardinality_partitions,
@@ -55,6 +100,77 @@ bool MEWCP_is_node_little_enough(list_blocked_nodes_t * list_blocked_nodes,
 								const unsigned int num_partitions,
 								const unsigned int cardinality_partitions,
 								const unsigned int max_solutions);
+
+/* Depth first enumeration: the partitions are fixed by increasing number of free nodes, the nodes of
+ * the partitions to fix keep their edges towards the fixed ones and the completion is bounded by their
+ * best remaining edges
+ */
+void MEWCP_compute_explicit_dfs(list_blocked_nodes_t * list_blocked_nodes,
+								bound_workspace_t * workspace,
+								matrix_weights_t * matrix_weights,
+								const unsigned num_partitions,
+								const unsigned int cardinality_partitions,
+								const double best_primal,
+								int * out_best_list_nodes_solution,
+								double * out_z_best_solution);
+
+/* Free lists, order and best edges of the enumeration, the num_split_partitions largest partitions are
+ * fixed first. False if a partition has no free node
+ */
+bool MEWCP_prepare_explicit_dfs(list_blocked_nodes_t * list_blocked_nodes,
+								bound_workspace_t * workspace,
+								matrix_weights_t * matrix_weights,
+								const unsigned num_partitions,
+								const unsigned int cardinality_partitions,
+								const unsigned int num_split_partitions);
+
+void MEWCP_explicit_dfs_level(bound_workspace_t * workspace,
+								matrix_weights_t * matrix_weights,
+								const unsigned num_partitions,
+								const unsigned int depth,
+								const double partial_value,
+								const double best_primal,
+								int * out_best_list_nodes_solution,
+								double * z_best);
+
+/* Fixes (or releases) v in the partition of the given depth for the partitions after it */
+void MEWCP_link_explicit_node(bound_workspace_t * workspace,
+								matrix_weights_t * matrix_weights,
+								const unsigned num_partitions,
+								const unsigned int depth,
+								const int v,
+								const bool fix);
+
+/* Optimistic value of the partitions from depth on added to partial_value, MEWCP_MIN_DOUBLE if one is empty */
+double MEWCP_bound_explicit_completion(bound_workspace_t * workspace,
+								matrix_weights_t * matrix_weights,
+								const unsigned num_partitions,
+								const unsigned int depth,
+								const double partial_value);
+
+/* The free lists of the workspace are generated and workspace->dfs_partitions is ordered by increasing number of free nodes */
+void MEWCP_order_explicit_partitions(list_blocked_nodes_t * list_blocked_nodes, bound_workspace_t * workspace,
+								const unsigned int num_partitions,
+								const unsigned int cardinality_partitions);
+
+/* Steps of the depth first enumeration without pruning: the internal nodes update and bound the free nodes,
+ * the last partition is a loop. Stops counting beyond max_work
+ */
+double MEWCP_estimate_explicit_work(list_blocked_nodes_t * list_blocked_nodes, bound_workspace_t * workspace,
+								const unsigned int num_partitions,
+								const unsigned int cardinality_partitions,
+								const double max_work);
+
+/* Tells if the node is solved by the explicit enumeration: work estimate or number of solutions */
+bool MEWCP_is_node_explicit(list_blocked_nodes_t * list_blocked_nodes, bound_workspace_t * workspace,
+								const unsigned int num_partitions,
+								const unsigned int cardinality_partitions);
+
+/* The root can take the work of all the threads */
+bool MEWCP_is_root_explicit(list_blocked_nodes_t * list_blocked_nodes, bound_workspace_t * workspace,
+								const unsigned int num_partitions,
+								const unsigned int cardinality_partitions,
+								const unsigned int num_threads);
 /*
  * ALLOCATION FUNCTIONS 
  */
@@ -319,22 +319,23 @@ void MEWCP_create_matrix_weights(const unsigned int n, const unsigned int m, mat
     matrix_weights->n = n;
     matrix_weights->m = m;
     matrix_weights->c = n/m;
+    matrix_weights->sorted_neighbours = NULL;
+    matrix_weights->conflict_start = NULL;
+    matrix_weights->conflict_nodes = NULL;
+    matrix_weights->num_conflicts = 0;
 
+    /* The rows are one block of n x n, the batch evaluation gathers from it */
     matrix_weights->weight = (weight_t **) malloc(sizeof(weight_t *) * n);
-    for(i = 0; i< n; ++ i)
+    matrix_weights->weight[0] = (weight_t *) malloc(sizeof(weight_t) * n * n);
+    for(i = 1; i< n; ++ i)
     {
-        matrix_weights -> weight[i] = (weight_t *) malloc(sizeof(weight_t) * n);
+        matrix_weights -> weight[i] = matrix_weights->weight[0] + i*n;
     }
 }
 
 void MEWCP_free_matrix_weights(matrix_weights_t * matrix_weights)
 {
-    unsigned int i;
-
-    for(i = 0; i < matrix_weights->n; ++ i)
-    {
-        free( matrix_weights -> weight[i]);
-    }
+    free(matrix_weights->weight[0]);
     free(matrix_weights->weight);
     matrix_weights -> n=0;
     matrix_weights -> m=0;
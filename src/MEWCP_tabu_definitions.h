@@ -35,7 +35,11 @@ typedef struct matrix_weights_s
     unsigned int n;  // Number of vertex
     unsigned int m;  // Number of partitions
     unsigned int c;  // Cardinality of each partition
-    weight_t ** weight;
+    weight_t ** weight;  // Its rows are one block, weight[i] = weight[0] + i*n
+    int * sorted_neighbours;  // For the B&B bounds, NULL if not built (see MEWCP_compute_sorted_neighbours)
+    unsigned int * conflict_start;  // n+1, the nodes in conflict with i are conflict_nodes[conflict_start[i] .. conflict_start[i+1]-1], NULL if none
+    unsigned int * conflict_nodes;  // Sorted by row, i and j in conflict are not together in a solution better than the incumbent
+    unsigned int num_conflicts;  // Number of pairs i<j in conflict
 }
 matrix_weights_t;
 
@@ -5,6 +5,7 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../MEWCP_combinatorial_bound.c \
+../MEWCP_cutting_planes.c \
 ../MEWCP_dsdp.c \
 ../MEWCP_explicit_enumeration.c \
 ../MEWCP_tabu.c \
@@ -13,6 +14,7 @@ C_SRCS += \
 
 OBJS += \
 ./MEWCP_combinatorial_bound.o \
+./MEWCP_cutting_planes.o \
 ./MEWCP_dsdp.o \
 ./MEWCP_explicit_enumeration.o \
 ./MEWCP_tabu.o \
@@ -21,6 +23,7 @@ OBJS += \
 
 C_DEPS += \
 ./MEWCP_combinatorial_bound.d \
+./MEWCP_cutting_planes.d \
 ./MEWCP_dsdp.d \
 ./MEWCP_explicit_enumeration.d \
 ./MEWCP_tabu.d \
@@ -32,7 +35,7 @@ C_DEPS += \
 %.o: ../%.c
 	@echo 'Building file: $<'
 	@echo 'Invoking: GCC C Compiler'
-	gcc -O3 -Wall -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.d)" -o"$@" "$<"
+	gcc -O3 -Wall -pthread -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.d)" -o"$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -30,7 +30,7 @@ void MEWCP_generate_sdp_constraints(matrix_weights_t * matrix_weights, constrain
 
 
 
-    unsigned int n,m,c,k;
+    unsigned int n,m,k;
     unsigned int number_constraints = 0;
     unsigned int num_blocks;
     unsigned int vector_length;
@@ -57,9 +57,6 @@ void MEWCP_generate_sdp_constraints(matrix_weights_t * matrix_weights, constrain
         exit(EXIT_FAILURE);
     }
 
-    /* c is the cardinality of each partition Vk, k=1,..,m */
-    c=n/m;
-
     /* The number of elements of the matrix is */
     vector_length = n*(n+1)/2;
 
@@ -120,22 +117,64 @@ void MEWCP_generate_sdp_constraints(matrix_weights_t * matrix_weights, constrain
     *vect_mat_braching_constraints = MEWCP_allocate_vect_mat_branching_constraints(vector_length);
 
     /* I allocate sdp_constraints_matrix and vector bi */
-    *sdp_constraints_matrix = MEWCP_allocate_sdp_constraints_matrix(n,number_constraints);
+    *sdp_constraints_matrix = MEWCP_allocate_sdp_constraints_matrix(number_constraints);
     *bi = MEWCP_allocate_bi(number_constraints);
 
+    /* The constraints have no storage yet: the writers only count their nonzeros */
+    MEWCP_write_sdp_constraints(matrix_weights,*sdp_constraints_matrix,*bi,number_constraints,
+                                c_cardinality,c_simple_MC,c_improved_MC_A,c_improved_MC_B,c_improved_MC_C,c_4C2,c_4C3_A,c_4C3_B);
+
+    /* One block sized on the counts is shared by all the constraints, then they are written */
+    MEWCP_allocate_sdp_constraints_storage(*sdp_constraints_matrix,number_constraints);
+    k = MEWCP_write_sdp_constraints(matrix_weights,*sdp_constraints_matrix,*bi,number_constraints,
+                                    c_cardinality,c_simple_MC,c_improved_MC_A,c_improved_MC_B,c_improved_MC_C,c_4C2,c_4C3_A,c_4C3_B);
+
+    /* I write the bi of the branching constraints */
+    MEWCP_write_b_branching(*bi,k-1);
+    k += 1;
+
+    /* 	Fine generazione matrici dei vincoli */
+
+    /* I set the out variable */
+
+    *out_num_contraints = number_constraints;   // branching constraints included
+
+
+#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
 
+    printf("\n** End generating contraints **\n");
+#endif
+}
 
 
+unsigned int MEWCP_write_sdp_constraints(matrix_weights_t * matrix_weights, constraint_t * sdp_constraints_matrix, double * bi,
+                                         const unsigned int number_constraints,
+                                         bool c_cardinality,
+                                         bool c_simple_MC,
+                                         bool c_improved_MC_A,
+                                         bool c_improved_MC_B,
+                                         bool c_improved_MC_C,
+                                         bool c_4C2,
+                                         bool c_4C3_A,
+                                         bool c_4C3_B)
+{
+    unsigned int n,m,c,k;
+    unsigned int vector_length;
+
+    n = matrix_weights->n;
+    m = matrix_weights->m;
+    c = n/m;
+    vector_length = n*(n+1)/2;
 
     /******		BEGIN CONTRAINTS	********/
     /*	MATRIX related to variable i=0  is W  */
 
     k=0;
 
-    MEWCP_write_constraints_weights_matrix(matrix_weights, *sdp_constraints_matrix,vector_length, n,k);
+    MEWCP_write_constraints_weights_matrix(matrix_weights, sdp_constraints_matrix,vector_length, n,k);
 #if defined MEWCP_CONVERTER_DSDP_DEBUG
 
-    MEWCP_print_contraints_matrix(*sdp_constraints_matrix,number_constraints,vector_length);
+    MEWCP_print_contraints_matrix(sdp_constraints_matrix,number_constraints,vector_length);
 #endif
 
     /* I start writing constraints */
@@ -143,124 +182,110 @@ void MEWCP_generate_sdp_constraints(matrix_weights_t * matrix_weights, constrain
 
     if (c_cardinality == true)
     {
-        MEWCP_write_constraints_cardinality(*sdp_constraints_matrix,vector_length,n,k);
-        MEWCP_write_b_cardinality(*bi,k-1,m);
+        MEWCP_write_constraints_cardinality(sdp_constraints_matrix,vector_length,n,k);
+        MEWCP_write_b_cardinality(bi,k-1,m);
         k += 1;
 #if defined MEWCP_CONVERTER_DSDP_DEBUG
 
-        MEWCP_print_contraints_matrix(*sdp_constraints_matrix,number_constraints,vector_length);
-        MEWCP_print_vectorY(*bi,number_constraints);
+        MEWCP_print_contraints_matrix(sdp_constraints_matrix,number_constraints,vector_length);
+        MEWCP_print_vectorY(bi,number_constraints);
 #endif
 
     }
     if ( c_simple_MC == true )
     {
-        MEWCP_write_constraints_simple_MC(*sdp_constraints_matrix,vector_length,n,c,k);
+        MEWCP_write_constraints_simple_MC(sdp_constraints_matrix,vector_length,n,c,k);
 
-        MEWCP_write_b_simple_MC(*bi,k-1,n,m);
+        MEWCP_write_b_simple_MC(bi,k-1,n,m);
         k += m;
 
 
 #if defined MEWCP_CONVERTER_DSDP_DEBUG
 
-        MEWCP_print_contraints_matrix(*sdp_constraints_matrix,number_constraints,vector_length);
-        MEWCP_print_vectorY(*bi,number_constraints);
+        MEWCP_print_contraints_matrix(sdp_constraints_matrix,number_constraints,vector_length);
+        MEWCP_print_vectorY(bi,number_constraints);
 #endif
 
     }
     if ( c_improved_MC_A == true )
     {
-        MEWCP_write_constraints_improved_MC_A(*sdp_constraints_matrix,vector_length,n,c,k);
-        MEWCP_write_b_improved_MC_A(*bi,k-1,n);
+        MEWCP_write_constraints_improved_MC_A(sdp_constraints_matrix,vector_length,n,c,k);
+        MEWCP_write_b_improved_MC_A(bi,k-1,n);
 
         k += n;
 #if defined MEWCP_CONVERTER_DSDP_DEBUG
 
-        MEWCP_print_contraints_matrix(*sdp_constraints_matrix,number_constraints,vector_length);
-        MEWCP_print_vectorY(*bi,number_constraints);
+        MEWCP_print_contraints_matrix(sdp_constraints_matrix,number_constraints,vector_length);
+        MEWCP_print_vectorY(bi,number_constraints);
 #endif
 
     }
     if ( c_improved_MC_B == true )
     {
-        MEWCP_write_constraints_improved_MC_B(*sdp_constraints_matrix,vector_length,n,m,c,k);
-        MEWCP_write_b_improved_MC_B(*bi,k-1,n,m);
+        MEWCP_write_constraints_improved_MC_B(sdp_constraints_matrix,vector_length,n,m,c,k);
+        MEWCP_write_b_improved_MC_B(bi,k-1,n,m);
 
         k += n*(m-1);
 #if defined MEWCP_CONVERTER_DSDP_DEBUG
 
-        MEWCP_print_contraints_matrix(*sdp_constraints_matrix,number_constraints,vector_length);
-        MEWCP_print_vectorY(*bi,number_constraints);
+        MEWCP_print_contraints_matrix(sdp_constraints_matrix,number_constraints,vector_length);
+        MEWCP_print_vectorY(bi,number_constraints);
 #endif
 
     }
     if ( c_improved_MC_C == true )
     {
-        MEWCP_write_constraints_improved_MC_C(*sdp_constraints_matrix,vector_length,m,c,k);
-        MEWCP_write_b_improved_MC_C(*bi,k-1,m);
+        MEWCP_write_constraints_improved_MC_C(sdp_constraints_matrix,vector_length,m,c,k);
+        MEWCP_write_b_improved_MC_C(bi,k-1,m);
         k += m;
 #if defined MEWCP_CONVERTER_DSDP_DEBUG
 
-        MEWCP_print_contraints_matrix(*sdp_constraints_matrix,number_constraints,vector_length);
-        MEWCP_print_vectorY(*bi,number_constraints);
+        MEWCP_print_contraints_matrix(sdp_constraints_matrix,number_constraints,vector_length);
+        MEWCP_print_vectorY(bi,number_constraints);
 #endif
 
     }
     if ( c_4C2 == true )
     {
-        MEWCP_write_constraints_4C2(*sdp_constraints_matrix,vector_length,n,m,c,k);
-        MEWCP_write_b_4C2(*bi,k-1);
+        MEWCP_write_constraints_4C2(sdp_constraints_matrix,vector_length,n,m,c,k);
+        MEWCP_write_b_4C2(bi,k-1);
         k += 1;
 #if defined MEWCP_CONVERTER_DSDP_DEBUG
 
-        MEWCP_print_contraints_matrix(*sdp_constraints_matrix,number_constraints,vector_length);
-        MEWCP_print_vectorY(*bi,number_constraints);
+        MEWCP_print_contraints_matrix(sdp_constraints_matrix,number_constraints,vector_length);
+        MEWCP_print_vectorY(bi,number_constraints);
 #endif
 
     }
     if ( c_4C3_A == true )
     {
 
-        MEWCP_write_constraints_4C3_A(*sdp_constraints_matrix,vector_length,n,m,c,k);
-        MEWCP_write_b_4C3_A(*bi,k-1,n);
+        MEWCP_write_constraints_4C3_A(sdp_constraints_matrix,vector_length,n,m,c,k);
+        MEWCP_write_b_4C3_A(bi,k-1,n);
 
         k += n;
 #if defined MEWCP_CONVERTER_DSDP_DEBUG
 
-        MEWCP_print_contraints_matrix(*sdp_constraints_matrix,number_constraints,vector_length);
-        MEWCP_print_vectorY(*bi,number_constraints);
+        MEWCP_print_contraints_matrix(sdp_constraints_matrix,number_constraints,vector_length);
+        MEWCP_print_vectorY(bi,number_constraints);
 #endif
 
     }
     if ( c_4C3_B == true )
     {
-        MEWCP_write_constraints_4C3_B( *sdp_constraints_matrix,vector_length,n,m,c,k)
+        MEWCP_write_constraints_4C3_B( sdp_constraints_matrix,vector_length,n,m,c,k)
         ;
-        MEWCP_write_b_4C3_B(*bi,k-1,n,m);
+        MEWCP_write_b_4C3_B(bi,k-1,n,m);
         k += n;
 #if defined MEWCP_CONVERTER_DSDP_DEBUG
 
-        MEWCP_print_contraints_matrix(*sdp_constraints_matrix,number_constraints,vector_length);
-        MEWCP_print_vectorY(*bi,number_constraints);
+        MEWCP_print_contraints_matrix(sdp_constraints_matrix,number_constraints,vector_length);
+        MEWCP_print_vectorY(bi,number_constraints);
 #endif
 
     }
 
-    /* I write the bi of the branching constraints */
-    MEWCP_write_b_branching(*bi,k-1);
-    k += 1;
-
-    /* 	Fine generazione matrici dei vincoli */
-
-    /* I set the out variable */
-
-    *out_num_contraints = number_constraints;   // branching constraints included
-
-
-#if defined MEWCP_CONVERTER_DSDP_VERBOSE1
-
-    printf("\n** End generating contraints **\n");
-#endif
+    return k;
 }
 
 
@@ -358,14 +383,12 @@ void MEWCP_write_constraints_weights_matrix(matrix_weights_t * matrix_weights, c
             if (i != j)
             {
 
-                sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                sdp_constraints_matrix[k].weight[pos_elem] = -(double) w/2;
+                MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,-(double) w/2);
                 ++pos_elem;
             }
             else
             {
-                sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                sdp_constraints_matrix[k].weight[pos_elem] = -(double) w;
+                MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,-(double) w);
                 pos_elem++;
             }
 
@@ -402,8 +425,7 @@ void MEWCP_write_constraints_cardinality( constraint_t * sdp_constraints_matrix,
     {
         pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(i+1,i+1);
 
-        sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-        sdp_constraints_matrix[k].weight[pos_elem] = (double) 1;
+        MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) 1);
         ++pos_elem;
 
 
@@ -435,8 +457,7 @@ void MEWCP_write_constraints_simple_MC( constraint_t * sdp_constraints_matrix, c
 
         pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(i,i);
 
-        sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-        sdp_constraints_matrix[k].weight[pos_elem] = (double) 1;
+        MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) 1);
         ++ pos_elem;
 
 
@@ -486,8 +507,7 @@ void MEWCP_write_constraints_improved_MC_A(constraint_t * sdp_constraints_matrix
             {
                 pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(j+1,i+1);
 
-                sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                sdp_constraints_matrix[k].weight[pos_elem] = (double) 1;
+                MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) 1);
                 ++ pos_elem;
 
 #if defined MEWCP_CONVERTER_DSDP_VERBOSE1
@@ -504,8 +524,7 @@ void MEWCP_write_constraints_improved_MC_A(constraint_t * sdp_constraints_matrix
 
                 pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(i+1,j+1);
 
-                sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                sdp_constraints_matrix[k].weight[pos_elem] = (double) 1;
+                MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) 1);
                 ++ pos_elem;
 
 #if defined MEWCP_CONVERTER_DSDP_VERBOSE1
@@ -556,8 +575,7 @@ void MEWCP_write_constraints_improved_MC_B( constraint_t * sdp_constraints_matri
 
             pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(v+1,v+1);
 
-            sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-            sdp_constraints_matrix[k].weight[pos_elem] = (double) -1;
+            MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) -1);
             ++ pos_elem;
 
 
@@ -574,8 +592,7 @@ void MEWCP_write_constraints_improved_MC_B( constraint_t * sdp_constraints_matri
 
                     pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(i+1,v+1);
 
-                    sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                    sdp_constraints_matrix[k].weight[pos_elem] = (double) 0.5;
+                    MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) 0.5);
                     ++ pos_elem;
 
 
@@ -591,8 +608,7 @@ void MEWCP_write_constraints_improved_MC_B( constraint_t * sdp_constraints_matri
                 if (i<v)
                 {
                     pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(v+1,i+1);
-                    sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                    sdp_constraints_matrix[k].weight[pos_elem] = (double) 0.5;
+                    MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) 0.5);
                     ++ pos_elem;
 
 
@@ -636,8 +652,7 @@ void MEWCP_write_constraints_improved_MC_C( constraint_t * sdp_constraints_matri
                 if (z<j)
                 {
                     pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(j+1,z+1);
-                    sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                    sdp_constraints_matrix[k].weight[pos_elem] = (double) 1;
+                    MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) 1);
                     ++ pos_elem;
 
 
@@ -681,8 +696,7 @@ void MEWCP_write_constraints_4C2( constraint_t * sdp_constraints_matrix, const u
             {
 
                 pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(i+1,j+1);
-                sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                sdp_constraints_matrix[k].weight[pos_elem] = 1-(double) m;
+                MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,1-(double) m);
                 ++ pos_elem;
 
 
@@ -699,8 +713,7 @@ void MEWCP_write_constraints_4C2( constraint_t * sdp_constraints_matrix, const u
 
                 pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(j+1,i+1);
 
-                sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                sdp_constraints_matrix[k].weight[pos_elem] = (double) 1;
+                MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) 1);
                 ++ pos_elem;
 
 
@@ -733,8 +746,7 @@ void MEWCP_write_constraints_4C3_A( constraint_t * sdp_constraints_matrix, const
         // I write  (i,i)= 1-m
         pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(i+1,i+1);
 
-        sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-        sdp_constraints_matrix[k].weight[pos_elem] = 1- (double ) m;
+        MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,1- (double ) m);
         ++ pos_elem;
 
 
@@ -752,8 +764,7 @@ void MEWCP_write_constraints_4C3_A( constraint_t * sdp_constraints_matrix, const
             if (((j<boundaries[0]) || (j>boundaries[1])) && i<=j)
             {
                 pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(j+1,i+1);
-                sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                sdp_constraints_matrix[k].weight[pos_elem] = (double) 0.5;
+                MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) 0.5);
                 ++ pos_elem;
 
 
@@ -775,8 +786,7 @@ void MEWCP_write_constraints_4C3_A( constraint_t * sdp_constraints_matrix, const
             {
                 pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(i+1,j+1);
 
-                sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                sdp_constraints_matrix[k].weight[pos_elem] = (double) 0.5;
+                MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) 0.5);
                 ++ pos_elem;
 
 
@@ -819,8 +829,7 @@ void MEWCP_write_constraints_4C3_B(constraint_t* sdp_constraints_matrix, const u
         // I write (i,i)= m
         pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(i+1,i+1);
 
-        sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-        sdp_constraints_matrix[k].weight[pos_elem] = (double) m;
+        MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) m);
         ++ pos_elem;
 
 
@@ -838,8 +847,7 @@ void MEWCP_write_constraints_4C3_B(constraint_t* sdp_constraints_matrix, const u
             {
                 pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(j+1,j+1);
 
-                sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                sdp_constraints_matrix[k].weight[pos_elem] = (double) 1;
+                MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) 1);
                 ++ pos_elem;
 
 
@@ -860,8 +868,7 @@ void MEWCP_write_constraints_4C3_B(constraint_t* sdp_constraints_matrix, const u
             {
                 pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(j+1,i+1);
 
-                sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                sdp_constraints_matrix[k].weight[pos_elem] = (double) -0.5;
+                MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) -0.5);
                 ++ pos_elem;
 
 
@@ -881,8 +888,7 @@ void MEWCP_write_constraints_4C3_B(constraint_t* sdp_constraints_matrix, const u
             {
                 pos_vect_matrix = MEWCP_convert_coords_ij_to_vector_matrix(i+1,j+1);
 
-                sdp_constraints_matrix[k].index[pos_elem] = pos_vect_matrix;
-                sdp_constraints_matrix[k].weight[pos_elem] = (double) -0.5;
+                MEWCP_set_constraint_element(&sdp_constraints_matrix[k],pos_elem,pos_vect_matrix,(double) -0.5);
                 ++ pos_elem;
 
 
@@ -905,6 +911,18 @@ void MEWCP_write_constraints_4C3_B(constraint_t* sdp_constraints_matrix, const u
 }
 
 
+void MEWCP_set_constraint_element(constraint_t * constraint, const unsigned int pos_elem, const unsigned int pos_vect_matrix, const double weight)
+{
+    /* Without storage the constraint is being counted */
+    if (constraint->index == NULL)
+    {
+        return;
+    }
+    constraint->index[pos_elem] = pos_vect_matrix;
+    constraint->weight[pos_elem] = weight;
+}
+
+
 /*************************************************************************
  * 
  * filling vector bi 
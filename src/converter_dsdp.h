@@ -27,6 +27,20 @@ void MEWCP_generate_sdp_constraints(matrix_weights_t * matrix_weights, constrain
                                     unsigned int * out_num_contraints
                                    );
 
+/* Writes W and the selected families, returns the position of the branching constraint. Called on
+ * constraints without storage it only counts their nonzeros
+ */
+unsigned int MEWCP_write_sdp_constraints(matrix_weights_t * matrix_weights, constraint_t * sdp_constraints_matrix, double * bi,
+                                         const unsigned int number_constraints,
+                                         bool c_cardinality,
+                                         bool c_simple_MC,
+                                         bool c_improved_MC_A,
+                                         bool c_improved_MC_B,
+                                         bool c_improved_MC_C,
+                                         bool c_4C2,
+                                         bool c_4C3_A,
+                                         bool c_4C3_B);
+
 
 
 
@@ -44,6 +58,7 @@ void MEWCP_write_constraints_improved_MC_C(constraint_t * sdp_constraints_matrix
 void MEWCP_write_constraints_4C2(constraint_t * sdp_constraints_matrix, const unsigned int vector_length, const unsigned int n, const unsigned int m, const unsigned int c,  unsigned int k);
 void MEWCP_write_constraints_4C3_A(constraint_t * sdp_constraints_matrix, const unsigned int vector_length, const unsigned int n, const unsigned int m, const unsigned int c,  unsigned int k);
 void MEWCP_write_constraints_4C3_B(constraint_t * sdp_constraints_matrix, const unsigned int vector_length, const unsigned int n, const unsigned int m, const unsigned int c,  unsigned int k);
+void MEWCP_set_constraint_element(constraint_t * constraint, const unsigned int pos_elem, const unsigned int pos_vect_matrix, const double weight);
 void MEWCP_generate_constraints_branch(list_blocked_nodes_t * list_blocked_nodes, constraint_t * vect_mat_contraints, const unsigned int vector_length, const unsigned int n, const unsigned int c);
 
 /*	FUNZIONI PER SCRIVERE I TERMINI NOTI DEI VINCOLI */
@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <time.h>
 #include <sys/times.h>
 
@@ -16,6 +17,7 @@
 #include "dsdp/dsdp5.h"
 #include "converter_dsdp.h"
 #include "MEWCP_dsdp.h"
+#include "MEWCP_cutting_planes.h"
 #include "MEWCP_tabu.h"
 #include "MEWCP_tabu_definitions.h"
 
@@ -26,6 +28,10 @@
 
 void show_usage(void);
 
+/* Reads the options -xxx from command line, the other arguments are returned in positional_args.
+ * Returns false if an option is wrong */
+bool parse_bb_parameters(int argc, char * argv[], bb_parameters_t * bb_parameters, char ** positional_args, int * num_positional_args);
+
 int main (int argc, char * argv[])
 {
     /* Variables to decide which constrains are enabled */
@@ -65,6 +71,9 @@ int main (int argc, char * argv[])
     constraint_t * constraints_matrix;
     solution_bb_t * solution_bb;
 
+    /* Constraints of the disabled families, separated as cuts */
+    cut_pool_t * cut_pool;
+
     /* variables to take time */
     double t_user;
     double t_system;
@@ -87,8 +96,14 @@ int main (int argc, char * argv[])
 
     tabu_result_t tabu_result;
 
+    /* B&B parameters */
+    bb_parameters_t bb_parameters;
+    char * positional_args[3];
+    int num_positional_args;
+
     /* Checking parameters number */
-    if(argc != 4 && argc != 3)
+    if( (parse_bb_parameters(argc,argv,&bb_parameters,positional_args,&num_positional_args) == false) ||
+        (num_positional_args != 3 && num_positional_args != 2) )
     {
         show_usage();
         return EXIT_SUCCESS;
@@ -98,12 +113,12 @@ int main (int argc, char * argv[])
     /* Parsing time limit */
     time_limit = 3600;
 
-    iterations = atoi(argv[1]);
-    filename_in = argv[2];
-    if (argc == 4)
+    iterations = atoi(positional_args[0]);
+    filename_in = positional_args[1];
+    if (num_positional_args == 3)
     {
 
-        filename_out = argv[3];
+        filename_out = positional_args[2];
     }
 
 
@@ -139,6 +154,16 @@ int main (int argc, char * argv[])
                                    c_4C3_B,
                                    &num_constraints);
 
+    cut_pool = NULL;
+#if defined CUTTING_PLANES_ACTIVE
+    /* The constraints of the disabled families are built from X by the separator, not stored.
+     * It knows the families that are usually left out, simple MC, improved MC A and 4C'' are not separated */
+    cut_pool = MEWCP_allocate_cut_pool(matrix_weights.n,matrix_weights.m,
+                                       !c_cardinality,
+                                       !c_improved_MC_B,!c_improved_MC_C,
+                                       !c_4C3_A,
+                                       !c_4C3_B);
+#endif
 
     dim_matrix = num_nodes*(num_nodes +1)/2;
 
@@ -161,7 +186,7 @@ int main (int argc, char * argv[])
     MEWCP_clone_vect_y(bi,open_node->vect_y,num_constraints);
 
 
-    solution_bb = MEWCP_branch_and_bound(open_node,constraints_matrix, &matrix_weights,bi,num_constraints,dim_matrix,num_nodes,num_partitions,tabu_result.solution.Z,tabu_result.solution.node_solution,time_limit);
+    solution_bb = MEWCP_branch_and_bound(open_node,constraints_matrix, &matrix_weights,bi,num_constraints,dim_matrix,num_nodes,num_partitions,tabu_result.solution.Z,tabu_result.solution.node_solution,time_limit,&bb_parameters,cut_pool);
 
 
 
@@ -173,7 +198,7 @@ int main (int argc, char * argv[])
 
 #if !defined ROOT_NODE_SIMULATION_ONLY
 
-    printf("%s Z_opt: %.2lf  DB_left: %.2lf  r_best_PB: %.2lf  r_DB: %.2lf  r_gap: %.2lf %%  t_root: %.2lf  Best_n: %u  depth_best: %u   Exp_nodes: %u   max_depth: %u  Time: %.2lf",
+    printf("%s Z_opt: %.2lf  DB_left: %.2lf  r_best_PB: %.2lf  r_DB: %.2lf  r_gap: %.2lf %%  t_root: %.2lf  Best_n: %u  depth_best: %u   Exp_nodes: %u   max_depth: %u  Time: %.2lf  Threads: %u  Wall: %.2lf  Lazy_pruned: %u  DSDP_its: %u  Tightened: %u  Fixed: %u",
            filename_in,
            solution_bb->z_opt,
            solution_bb->best_bound_left,
@@ -185,7 +210,13 @@ int main (int argc, char * argv[])
            solution_bb->depth_best_primal,
            solution_bb->number_explored_nodes,
            solution_bb->max_exploration_depth,
-           (t_user-t_user_start) + ( t_system-t_system_start) );
+           (t_user-t_user_start) + ( t_system-t_system_start),
+           bb_parameters.num_threads,
+           solution_bb->wall_time,
+           solution_bb->number_lazy_pruned_nodes,
+           solution_bb->number_sdp_iterations,
+           solution_bb->number_sdp_tightened,
+           solution_bb->number_fixed_nodes );
 #endif
 
 #if defined ROOT_NODE_SIMULATION_ONLY
@@ -212,7 +243,7 @@ int main (int argc, char * argv[])
         }
 
 #if !defined ROOT_NODE_SIMULATION_ONLY
-        fprintf(file_out ,"%s Z_opt: %.2lf\tDB_left: %.2lf\tr_best_PB: %.2lf\tr_DB: %.2lf\tr_gap: %.2lf %%\tt_root: %.2lf\t Best_n: %u\t depth_best: %u \t Exp_nodes: %u \t max_depth: %u \t Time: %.2lf",
+        fprintf(file_out ,"%s Z_opt: %.2lf\tDB_left: %.2lf\tr_best_PB: %.2lf\tr_DB: %.2lf\tr_gap: %.2lf %%\tt_root: %.2lf\t Best_n: %u\t depth_best: %u \t Exp_nodes: %u \t max_depth: %u \t Time: %.2lf \t Threads: %u \t Wall: %.2lf \t Lazy_pruned: %u \t DSDP_its: %u \t Tightened: %u \t Fixed: %u",
                 filename_in,
                 solution_bb->z_opt,
                 solution_bb->best_bound_left,
@@ -224,7 +255,13 @@ int main (int argc, char * argv[])
                 solution_bb->depth_best_primal,
                 solution_bb->number_explored_nodes,
                 solution_bb->max_exploration_depth,
-                (t_user-t_user_start) + ( t_system-t_system_start) );
+                (t_user-t_user_start) + ( t_system-t_system_start),
+                bb_parameters.num_threads,
+                solution_bb->wall_time,
+                solution_bb->number_lazy_pruned_nodes,
+                solution_bb->number_sdp_iterations,
+                solution_bb->number_sdp_tightened,
+                solution_bb->number_fixed_nodes );
 #endif
 
 
@@ -248,6 +285,10 @@ int main (int argc, char * argv[])
     MEWCP_free_matrix_weights(&matrix_weights);
     MEWCP_free_node_list(&node_list);
     MEWCP_free_solution_bb(solution_bb);
+    if (cut_pool != NULL)
+    {
+        MEWCP_free_cut_pool(cut_pool);
+    }
 
     return EXIT_SUCCESS;
 }
@@ -267,5 +308,127 @@ void show_usage(void)
     printf("\t\t1) number tabu search iterations\n");
     printf("\t\t2) instance in format .dat\n");
     printf("\t\t3) <output file (optional)>\n");
+    printf("Options:\n");
+    printf("\t\t-threads <n>\tnumber of B&B workers (default %d)\n",MEWCP_DEFAULT_NUM_THREADS);
+    printf("\t\t-scheduler <shared|stealing>\topen nodes in one best-first list (default) or\n");
+    printf("\t\t\t\tone list per worker with depth-first dives and work stealing\n");
+    printf("\t\t-select <best|depth|estimate|hybrid>\tnode selection of the shared list:\n");
+    printf("\t\t\t\tbest bound (default), deepest node, best estimate,\n");
+    printf("\t\t\t\tdepth first until both sons are closed then best bound\n");
+    printf("\t\t-branch <perfect|equi|maxfract|pseudocost>\tsplit of the partitions:\n");
+    printf("\t\t\t\thalf fractional mass (default), equi, max fractional,\n");
+    printf("\t\t\t\treliability branching on pseudo-costs\n");
+    printf("\t\t-lazy\tthe sons are bounded when popped, with the DB of the father until then\n");
     printf("\n");
 }
+
+bool parse_bb_parameters(int argc, char * argv[], bb_parameters_t * bb_parameters, char ** positional_args, int * num_positional_args)
+{
+    int i;
+
+    bb_parameters->num_threads = MEWCP_DEFAULT_NUM_THREADS;
+    bb_parameters->scheduler = MEWCP_SCHEDULER_SHARED;
+    bb_parameters->node_selection = MEWCP_NODE_SELECTION_BEST_FIRST;
+    bb_parameters->branching_rule = MEWCP_BRANCHING_PERFECT_EQUI;
+    bb_parameters->lazy_bounding = false;
+    *num_positional_args = 0;
+
+    for (i=1; i<argc; ++i)
+    {
+        if (strcmp(argv[i],"-threads") == 0)
+        {
+            if ( (i+1 == argc) || (atoi(argv[i+1]) < 1) || (atoi(argv[i+1]) > MEWCP_MAX_NUM_THREADS) )
+            {
+                printf("!!! ERROR -threads needs a number between 1 and %d\n",MEWCP_MAX_NUM_THREADS);
+                return false;
+            }
+            bb_parameters->num_threads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i],"-scheduler") == 0)
+        {
+            if ( (i+1 < argc) && (strcmp(argv[i+1],"shared") == 0) )
+            {
+                bb_parameters->scheduler = MEWCP_SCHEDULER_SHARED;
+            }
+            else if ( (i+1 < argc) && (strcmp(argv[i+1],"stealing") == 0) )
+            {
+                bb_parameters->scheduler = MEWCP_SCHEDULER_STEALING;
+            }
+            else
+            {
+                printf("!!! ERROR -scheduler needs shared or stealing\n");
+                return false;
+            }
+            ++i;
+        }
+        else if (strcmp(argv[i],"-select") == 0)
+        {
+            if ( (i+1 < argc) && (strcmp(argv[i+1],"best") == 0) )
+            {
+                bb_parameters->node_selection = MEWCP_NODE_SELECTION_BEST_FIRST;
+            }
+            else if ( (i+1 < argc) && (strcmp(argv[i+1],"depth") == 0) )
+            {
+                bb_parameters->node_selection = MEWCP_NODE_SELECTION_DEPTH_FIRST;
+            }
+            else if ( (i+1 < argc) && (strcmp(argv[i+1],"estimate") == 0) )
+            {
+                bb_parameters->node_selection = MEWCP_NODE_SELECTION_BEST_ESTIMATE;
+            }
+            else if ( (i+1 < argc) && (strcmp(argv[i+1],"hybrid") == 0) )
+            {
+                bb_parameters->node_selection = MEWCP_NODE_SELECTION_HYBRID;
+            }
+            else
+            {
+                printf("!!! ERROR -select needs best, depth, estimate or hybrid\n");
+                return false;
+            }
+            ++i;
+        }
+        else if (strcmp(argv[i],"-branch") == 0)
+        {
+            if ( (i+1 < argc) && (strcmp(argv[i+1],"perfect") == 0) )
+            {
+                bb_parameters->branching_rule = MEWCP_BRANCHING_PERFECT_EQUI;
+            }
+            else if ( (i+1 < argc) && (strcmp(argv[i+1],"equi") == 0) )
+            {
+                bb_parameters->branching_rule = MEWCP_BRANCHING_EQUI;
+            }
+            else if ( (i+1 < argc) && (strcmp(argv[i+1],"maxfract") == 0) )
+            {
+                bb_parameters->branching_rule = MEWCP_BRANCHING_MAX_FRACTIONAL;
+            }
+            else if ( (i+1 < argc) && (strcmp(argv[i+1],"pseudocost") == 0) )
+            {
+                bb_parameters->branching_rule = MEWCP_BRANCHING_PSEUDO_COST;
+            }
+            else
+            {
+                printf("!!! ERROR -branch needs perfect, equi, maxfract or pseudocost\n");
+                return false;
+            }
+            ++i;
+        }
+        else if (strcmp(argv[i],"-lazy") == 0)
+        {
+            bb_parameters->lazy_bounding = true;
+        }
+        else if (argv[i][0] == '-')
+        {
+            printf("!!! ERROR unknown option %s\n",argv[i]);
+            return false;
+        }
+        else
+        {
+            if (*num_positional_args == 3)
+            {
+                return false;
+            }
+            positional_args[(*num_positional_args)++] = argv[i];
+        }
+    }
+
+    return true;
+}